@@ -62,6 +62,7 @@ void Processor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&
   }
 
   juce::ScopedNoDenormals noDenormals;
+  Uhhyou::LoadMeter::ScopedMeasure loadMeasure(loadMeter, buffer.getNumSamples(), getSampleRate());
 
   auto audioPlayHead = getPlayHead();
   if (audioPlayHead != nullptr) {
@@ -154,89 +154,126 @@ public:
   }};
 };
 
-template<typename Sample> class AnalyticSignalFilter {
+/*
+Pair of allpass chains whose outputs are 90 degrees apart. Real and imaginary chains of all inputs
+have the same structure, so they are processed as lanes of one cascade. Lane `2 * n` is the real
+part of input `n`, and lane `2 * n + 1` is the imaginary part. Loops over lanes are meant to be
+vectorized by compiler.
+*/
+template<typename Sample, size_t nInput = 1> class AnalyticSignalFilter {
 private:
-  constexpr static std::array<Sample, 4> coRe{
+  constexpr static size_t nSection = 4;
+  constexpr static size_t nLane = 2 * nInput;
+
+  constexpr static std::array<Sample, nSection> coRe{
     Sample(0.16175849836770106), Sample(0.7330289323414905), Sample(0.9453497003291133),
     Sample(0.9905991566845292)};
-  constexpr static std::array<Sample, 4> coIm{Sample(0.47940086558884), Sample(0.8762184935393101),
-                                              Sample(0.9765975895081993),
-                                              Sample(0.9974992559355491)};
+  constexpr static std::array<Sample, nSection> coIm{Sample(0.47940086558884),
+                                                     Sample(0.8762184935393101),
+                                                     Sample(0.9765975895081993),
+                                                     Sample(0.9974992559355491)};
+
+  constexpr static std::array<std::array<Sample, nLane>, nSection> makeLaneCoefficient() {
+    std::array<std::array<Sample, nLane>, nSection> co{};
+    for (size_t i = 0; i < nSection; ++i) {
+      for (size_t n = 0; n < nInput; ++n) {
+        co[i][2 * n] = coRe[i];
+        co[i][2 * n + 1] = coIm[i];
+      }
+    }
+    return co;
+  }
 
-  std::array<Sample, coRe.size()> x1Re_{};
-  std::array<Sample, coRe.size()> x2Re_{};
-  std::array<Sample, coRe.size()> y1Re_{};
-  std::array<Sample, coRe.size()> y2Re_{};
+  constexpr static std::array<std::array<Sample, nLane>, nSection> co = makeLaneCoefficient();
 
-  std::array<Sample, coIm.size()> x1Im_{};
-  std::array<Sample, coIm.size()> x2Im_{};
-  std::array<Sample, coIm.size()> y1Im_{};
-  std::array<Sample, coIm.size()> y2Im_{};
+  std::array<std::array<Sample, nLane>, nSection> x1_{};
+  std::array<std::array<Sample, nLane>, nSection> x2_{};
+  std::array<std::array<Sample, nLane>, nSection> y1_{};
+  std::array<std::array<Sample, nLane>, nSection> y2_{};
 
-  Sample delayedIm_ = 0;
+  std::array<Sample, nInput> delayedIm_{};
 
 public:
   void reset() {
-    x1Re_.fill(0);
-    x2Re_.fill(0);
-    y1Re_.fill(0);
-    y2Re_.fill(0);
-
-    x1Im_.fill(0);
-    x2Im_.fill(0);
-    y1Im_.fill(0);
-    y2Im_.fill(0);
-
-    delayedIm_ = 0;
+    for (size_t i = 0; i < nSection; ++i) {
+      x1_[i].fill(0);
+      x2_[i].fill(0);
+      y1_[i].fill(0);
+      y2_[i].fill(0);
+    }
+    delayedIm_.fill(0);
   }
 
-  std::complex<Sample> process(Sample input) {
-    auto sigRe = input;
-    for (size_t i = 0; i < coRe.size(); ++i) {
-      auto y0 = coRe[i] * (sigRe + y2Re_[i]) - x2Re_[i];
-      x2Re_[i] = x1Re_[i];
-      x1Re_[i] = sigRe;
-      y2Re_[i] = y1Re_[i];
-      y1Re_[i] = y0;
-      sigRe = y0;
+  std::array<std::complex<Sample>, nInput> process(const std::array<Sample, nInput>& input) {
+    std::array<Sample, nLane> sig;
+    for (size_t n = 0; n < nInput; ++n) {
+      sig[2 * n] = input[n];
+      sig[2 * n + 1] = input[n];
     }
 
-    auto sigIm = input;
-    for (size_t i = 0; i < coIm.size(); ++i) {
-      auto y0 = coIm[i] * (sigIm + y2Im_[i]) - x2Im_[i];
-      x2Im_[i] = x1Im_[i];
-      x1Im_[i] = sigIm;
-      y2Im_[i] = y1Im_[i];
-      y1Im_[i] = y0;
-      sigIm = y0;
+    for (size_t i = 0; i < nSection; ++i) {
+      std::array<Sample, nLane> y0;
+      for (size_t k = 0; k < nLane; ++k) { y0[k] = co[i][k] * (sig[k] + y2_[i][k]) - x2_[i][k]; }
+      x2_[i] = x1_[i];
+      x1_[i] = sig;
+      y2_[i] = y1_[i];
+      y1_[i] = y0;
+      sig = y0;
     }
-    auto outIm = delayedIm_;
-    delayedIm_ = sigIm; // 1 sample delay.
 
-    return std::complex<Sample>{sigRe, outIm};
+    std::array<std::complex<Sample>, nInput> output;
+    for (size_t n = 0; n < nInput; ++n) {
+      output[n] = {sig[2 * n], delayedIm_[n]};
+      delayedIm_[n] = sig[2 * n + 1]; // 1 sample delay.
+    }
+    return output;
+  }
+
+  std::complex<Sample> process(Sample input)
+    requires(nInput == 1)
+  {
+    return process(std::array<Sample, 1>{input})[0];
   }
 };
 
+/*
+Rotates the analytic signal by a unit phasor, which is `exp(2 pi i phase)`. The phasor is advanced
+by a complex multiplication instead of calling `cos` and `sin` on each sample.
+*/
 template<typename Sample> class FrequencyShifter {
 private:
   AnalyticSignalFilter<Sample> hilbert_;
-  Sample phase_ = 0;
+  Sample stepFreq_ = 0;
+  Sample stepRe_ = 1;
+  Sample stepIm_ = 0;
+  Sample phasorRe_ = 1;
+  Sample phasorIm_ = 0;
 
 public:
   void reset() {
     hilbert_.reset();
-    phase_ = 0;
+    phasorRe_ = 1;
+    phasorIm_ = 0;
   }
 
   // `shiftFreq` is normalized frequency in [0, 0.5).
   Sample process(Sample input, Sample shiftFreq) {
-    auto sig = hilbert_.process(input);
-    auto norm = std::sqrt(sig.real() * sig.real() + sig.imag() * sig.imag());
-    auto theta = std::atan2(sig.imag(), sig.real());
+    if (shiftFreq != stepFreq_) {
+      stepFreq_ = shiftFreq;
+      stepRe_ = std::cos(Sample(2 * std::numbers::pi) * shiftFreq);
+      stepIm_ = std::sin(Sample(2 * std::numbers::pi) * shiftFreq);
+    }
+
+    const auto re = phasorRe_ * stepRe_ - phasorIm_ * stepIm_;
+    const auto im = phasorRe_ * stepIm_ + phasorIm_ * stepRe_;
+
+    // One step of Newton's method for `1 / sqrt(norm)` prevents the magnitude from drifting.
+    const auto gain = Sample(0.5) * (Sample(3) - re * re - im * im);
+    phasorRe_ = gain * re;
+    phasorIm_ = gain * im;
 
-    phase_ += shiftFreq;
-    phase_ -= std::floor(phase_);
-    return norm * std::cos(theta + Sample(2 * std::numbers::pi) * phase_);
+    auto sig = hilbert_.process(input);
+    return sig.real() * phasorRe_ - sig.imag() * phasorIm_;
   }
 };
 
@@ -309,18 +346,13 @@ public:
 
 template<typename Sample> class UpperSideBandAmplitudeModulator {
 private:
-  AnalyticSignalFilter<Sample> carFilter_;
-  AnalyticSignalFilter<Sample> modFilter_;
+  AnalyticSignalFilter<Sample, 2> filter_; // Carrior and modulator.
 
 public:
-  void reset() {
-    carFilter_.reset();
-    modFilter_.reset();
-  }
+  void reset() { filter_.reset(); }
 
   Sample process(Sample carrior, Sample modulator) {
-    auto c0 = carFilter_.process(carrior);
-    auto m0 = modFilter_.process(modulator);
+    const auto [c0, m0] = filter_.process({carrior, modulator});
     return c0.real() * m0.real() - c0.imag() * m0.imag();
   }
 };
@@ -329,18 +361,13 @@ public:
 // `dspcore.cpp`.
 template<typename Sample> class LowerSideBandAmplitudeModulator {
 private:
-  AnalyticSignalFilter<Sample> carFilter_;
-  AnalyticSignalFilter<Sample> modFilter_;
+  AnalyticSignalFilter<Sample, 2> filter_; // Carrior and modulator.
 
 public:
-  void reset() {
-    carFilter_.reset();
-    modFilter_.reset();
-  }
+  void reset() { filter_.reset(); }
 
   Sample process(Sample carrior, Sample modulator) {
-    auto c0 = carFilter_.process(carrior);
-    auto m0 = modFilter_.process(modulator);
+    const auto [c0, m0] = filter_.process({carrior, modulator});
     return c0.real() * m0.real() + c0.imag() * m0.imag();
   }
 };
@@ -38,9 +38,16 @@ struct Metrics {
 
 const juce::String sShaper{"Shaper"};
 
-Editor::Editor(Processor& proc) : EditorBase(proc, informationText) {
+Editor::Editor(Processor& proc)
+    : EditorBase(proc, informationText),
+      lookaheadAttachment_(
+        *proc.param.tree.getParameter("lookahead"),
+        [this](float) { processor_.setLatencySamples(int(processor_.dsp.getLatency())); },
+        nullptr) {
   auto& sc = proc.param.scale;
 
+  val().displayTelemetry.clear(); // Records queued while the editor was closed are stale.
+
   addTextKnob(sShaper, "lowGain", sc.gain, {}, 5);
   addTextKnob(sShaper, "highGain", sc.gain, {}, 5);
   addTextKnob(sShaper, "crossoverHz", sc.cutoff, {}, 5);
@@ -49,6 +56,7 @@ Editor::Editor(Processor& proc) : EditorBase(proc, informationText) {
   addTextKnob(sShaper, "shaperIntensity", sc.gain, {}, 5);
   addTextKnob(sShaper, "shaperPostLowpassHz", sc.cutoff, {}, 5);
   addToggleButton(sShaper, "oversampling", sc.boolean, "", "", LabeledWidget::expand);
+  addToggleButton(sShaper, "lookahead", sc.boolean, "", "", LabeledWidget::expand);
 
   registerInteractive(envelopeDisplay_);
 
@@ -58,6 +66,11 @@ Editor::Editor(Processor& proc) : EditorBase(proc, informationText) {
   initWindow(mt.totalWidth, mt.totalHeight);
 }
 
+void Editor::drainTelemetry() {
+  val().displayTelemetry.drain(
+    [&](const DisplayRecord& record) { envelopeDisplay_.push(record); });
+}
+
 void Editor::resized() {
   EditorBase<Processor>::resized();
 
@@ -84,8 +97,9 @@ void Editor::resized() {
   envelopeDisplay_.setBounds(
     Rect{left1, nameTop0 + mt.labelY + mt.margin, mt.sectionWidth, 6 * mt.labelY - 2 * mt.margin});
 
-  statusBar_.setBounds(
-    Rect{left0, bottom - mt.labelH - mt.uiMargin, mt.totalWidth - 2 * mt.uiMargin, mt.labelH});
+  layoutStatusBar(
+    Rect{left0, bottom - mt.labelH - mt.uiMargin, mt.totalWidth - 2 * mt.uiMargin, mt.labelH},
+    mt.margin, mt.labelW);
 }
 
 } // namespace Uhhyou
@@ -21,7 +21,11 @@ public:
 
 private:
   decltype(processor_.param.value)& val() { return processor_.param.value; }
-  EnvelopeDisplay envelopeDisplay_{*this, palette_, val().inputPeakMax, val().modEnvelopeOutMax};
+  void drainTelemetry();
+
+  juce::ParameterAttachment lookaheadAttachment_;
+  EnvelopeDisplay envelopeDisplay_{*this, palette_};
+  AnimationSource telemetrySource_{*this, [this]() { drainTelemetry(); }};
 };
 
 } // namespace Uhhyou
@@ -7,6 +7,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_data_structures/juce_data_structures.h>
 
+#include "Uhhyou/dsp/loadmeter.hpp"
 #include "dsp/dspcore.hpp"
 #include "parameter.hpp"
 
@@ -51,6 +52,7 @@ public:
 
   Uhhyou::ParameterStore param;
   Uhhyou::DSPCore dsp;
+  Uhhyou::LoadMeter loadMeter;
   double previousSampleRate = double(-1);
 
 private:
@@ -17,6 +17,9 @@ void DSPCore::setup(double sampleRate) {
 
   smoo_.setTime(upRate_, smootherTimeInSecond);
 
+  lookaheadFrames_ = size_t(std::lround(lookaheadSecond * sampleRate_));
+  bandDelay_.resize(upFold * lookaheadFrames_);
+
   reset();
   startup();
 }
@@ -26,7 +29,18 @@ void DSPCore::updateUpRate() {
   smoo_.setTime(upRate_, smootherTimeInSecond);
 }
 
-size_t DSPCore::getLatency() { return splitter_[0].latency; }
+// Audio path is delayed relative to the detector, so that gain can follow the onset of transients.
+void DSPCore::updateLookahead() {
+  const size_t frames
+    = param.value.lookahead->load() != 0 ? (overSampling_ ? upFold : 1) * lookaheadFrames_ : 0;
+  bandDelay_.setFrames(frames);
+}
+
+// Latency is taken from parameters instead of delays, because this may be called from GUI thread.
+size_t DSPCore::getLatency() {
+  const size_t lookahead = param.value.lookahead->load() != 0 ? lookaheadFrames_ : 0;
+  return splitter_.latency + lookahead;
+}
 
 #define ASSIGN_PARAMETER(METHOD)                                                                   \
   auto& pv = param.value;                                                                          \
@@ -41,18 +55,21 @@ size_t DSPCore::getLatency() { return splitter_[0].latency; }
   highGain_.METHOD(pv.highGain->load() / std::sqrt(double(1) + intensity));
 
 void DSPCore::reset() {
+  // Smoothers are reset at the active rate. Otherwise they start from the values of the previous
+  // rate, and the detector, which is updated per block, diverges while they settle.
+  overSampling_ = unsigned(param.value.oversampling->load());
   updateUpRate();
+  updateLookahead();
 
   ASSIGN_PARAMETER(reset);
 
-  for (auto& x : pv.inputPeakMax) { x = float(0); }
-  for (auto& x : pv.modEnvelopeOutMax) { x = float(0); }
+  splitterKernel_.reset(crossoverCutoff_.value());
+  splitter_.reset();
+  envelopeHigh_.reset();
+  lowpass_.reset();
+  bandDelay_.reset();
 
-  for (auto& x : splitter_) { x.reset(); }
-  for (auto& x : envelopeHigh_) { x.reset(); }
-  for (auto& x : lowpass_) { x.reset(); }
-
-  for (auto& x : halfbandInput_) { x.fill({}); }
+  previousInput_.fill({});
   for (auto& x : halfbandIir_) { x.reset(); }
 
   startup();
@@ -66,87 +83,115 @@ void DSPCore::setParameters() {
     overSampling_ = newOverSampling;
     updateUpRate();
   }
+  updateLookahead();
   ASSIGN_PARAMETER(push);
 }
 
-std::array<double, 2> DSPCore::processSample(const std::array<double, 2> in) {
-  double sig0 = in[0];
-  double sig1 = in[1];
-
-  crossoverCutoff_.process();
-  auto split0 = splitter_[0].process(sig0, crossoverCutoff_.value());
-  auto split1 = splitter_[1].process(sig1, crossoverCutoff_.value());
-
-  shaperDecaySample_.process();
-  shaperRefreshRatio_.process();
-  double env0 = envelopeHigh_[0].process(split0.high, shaperDecaySample_.value(),
-                                         shaperRefreshRatio_.value());
-  double env1 = envelopeHigh_[1].process(split1.high, shaperDecaySample_.value(),
-                                         shaperRefreshRatio_.value());
-
-  shaperPostLowpassCutoff_.process();
-  env0 = lowpass_[0].process(env0, shaperPostLowpassCutoff_.value());
-  env1 = lowpass_[1].process(env1, shaperPostLowpassCutoff_.value());
-
-  modEnvelopeOutMax_[0] = std::max(modEnvelopeOutMax_[0], float(env0));
-  modEnvelopeOutMax_[1] = std::max(modEnvelopeOutMax_[1], float(env1));
-
-  shaperIntensity_.process();
-  split0.high *= double(1) + shaperIntensity_.value() * env0;
-  split1.high *= double(1) + shaperIntensity_.value() * env1;
-
-  lowGain_.process();
-  highGain_.process();
-  return {
-    lowGain_.value() * split0.low + highGain_.value() * split0.high,
-    lowGain_.value() * split1.low + highGain_.value() * split1.high,
+/*
+Processing is split into stages, so that each stage runs over a whole block:
+
+1. Band splitting and parameter smoothing. This is the only sample-serial stage in audio path.
+2. Envelope detection and post-lowpass on high band, with parameters fixed in a block.
+3. Lookahead delay.
+4. Gain, which is an element-wise loop to be vectorized.
+5. Downsampling.
+*/
+void DSPCore::processBlock(const size_t length, const float* in0, const float* in1, float* out0,
+                           float* out1) {
+  const size_t upLength = (overSampling_ == 1 ? upFold : 1) * length;
+
+  // Stage 1.
+  auto split = [&](size_t index, const Frame& input) {
+    crossoverCutoff_.process();
+    splitterKernel_.update(crossoverCutoff_.value());
+    const auto band = splitter_.process(input, splitterKernel_);
+    lowBuffer_[index] = band.low;
+    highBuffer_[index] = band.high;
+
+    shaperDecaySample_.process();
+    shaperRefreshRatio_.process();
+    shaperPostLowpassCutoff_.process();
+    intensityBuffer_[index] = shaperIntensity_.process();
+    lowGainBuffer_[index] = lowGain_.process();
+    highGainBuffer_[index] = highGain_.process();
   };
-}
-
-void DSPCore::process(const size_t length, const float* in0, const float* in1, float* out0,
-                      float* out1) {
-  auto& pv = param.value;
-
-  inputPeakMax_.fill(0);
-  modEnvelopeOutMax_.fill(0);
 
-  std::array<double, 2> frame{};
   for (size_t i = 0; i < length; ++i) {
     inputPeakMax_[0] = std::max(inputPeakMax_[0], std::abs(in0[i]));
     inputPeakMax_[1] = std::max(inputPeakMax_[1], std::abs(in1[i]));
 
-    const auto inSig0 = double(in0[i]);
-    const auto inSig1 = double(in1[i]);
-
+    const Frame input{double(in0[i]), double(in1[i])};
     if (overSampling_ == 1) { // 2x sampling.
-      frame = processSample({
-        double(0.5) * (halfbandInput_[0][0] + inSig0),
-        double(0.5) * (halfbandInput_[0][1] + inSig1),
-      });
-      halfbandInput_[0][0] = frame[0];
-      halfbandInput_[1][0] = frame[1];
-
-      frame = processSample({inSig0, inSig1});
-      halfbandInput_[0][1] = frame[0];
-      halfbandInput_[1][1] = frame[1];
-
-      frame[0] = halfbandIir_[0].process(halfbandInput_[0]);
-      frame[1] = halfbandIir_[1].process(halfbandInput_[1]);
+      split(2 * i,
+            {
+              double(0.5) * (previousInput_[0] + input[0]),
+              double(0.5) * (previousInput_[1] + input[1]),
+            });
+      split(2 * i + 1, input);
     } else { // 1x sampling.
-      frame = processSample({inSig0, inSig1});
+      split(i, input);
+    }
+    previousInput_ = input;
+  }
+
+  // Stage 2.
+  const double decay = envelopeHigh_.decayFactor(shaperDecaySample_.value());
+  const double refreshRatio = shaperRefreshRatio_.value();
+  lowpass_.setCutoff(shaperPostLowpassCutoff_.value());
+  for (size_t i = 0; i < upLength; ++i) {
+    const auto envelope = envelopeHigh_.process(highBuffer_[i], decay, refreshRatio);
+    envelopeBuffer_[i] = lowpass_.process(envelope);
+  }
+
+  for (size_t i = 0; i < upLength; ++i) {
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      modEnvelopeOutMax_[ch] = std::max(modEnvelopeOutMax_[ch], float(envelopeBuffer_[i][ch]));
     }
+  }
+
+  // Stage 3.
+  for (size_t i = 0; i < upLength; ++i) {
+    const auto delayed = bandDelay_.process({lowBuffer_[i], highBuffer_[i]});
+    lowBuffer_[i] = delayed[0];
+    highBuffer_[i] = delayed[1];
+  }
 
-    out0[i] = float(frame[0]);
-    out1[i] = float(frame[1]);
+  // Stage 4. Result is written to `lowBuffer_`.
+  for (size_t i = 0; i < upLength; ++i) {
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      const double modulation = double(1) + intensityBuffer_[i] * envelopeBuffer_[i][ch];
+      const double high = highBuffer_[i][ch] * modulation;
+      lowBuffer_[i][ch] = lowGainBuffer_[i] * lowBuffer_[i][ch] + highGainBuffer_[i] * high;
+    }
+  }
 
-    halfbandInput_[0][0] = inSig0;
-    halfbandInput_[0][1] = inSig1;
+  // Stage 5.
+  if (overSampling_ == 1) { // 2x sampling.
+    for (size_t i = 0; i < length; ++i) {
+      const auto& frame0 = lowBuffer_[2 * i];
+      const auto& frame1 = lowBuffer_[2 * i + 1];
+      out0[i] = float(halfbandIir_[0].process({frame0[0], frame1[0]}));
+      out1[i] = float(halfbandIir_[1].process({frame0[1], frame1[1]}));
+    }
+  } else { // 1x sampling.
+    for (size_t i = 0; i < length; ++i) {
+      out0[i] = float(lowBuffer_[i][0]);
+      out1[i] = float(lowBuffer_[i][1]);
+    }
   }
+}
+
+void DSPCore::process(const size_t length, const float* in0, const float* in1, float* out0,
+                      float* out1) {
+  inputPeakMax_.fill(0);
+  modEnvelopeOutMax_.fill(0);
 
-  for (size_t ch = 0; ch < nChannel; ++ch) {
-    pv.inputPeakMax[ch] = inputPeakMax_[ch];
-    pv.modEnvelopeOutMax[ch] = modEnvelopeOutMax_[ch];
+  for (size_t offset = 0; offset < length; offset += blockSize) {
+    const size_t blockLength = std::min(blockSize, length - offset);
+    processBlock(blockLength, in0 + offset, in1 + offset, out0 + offset, out1 + offset);
   }
+
+  if (length > 0) { param.value.displayTelemetry.push({inputPeakMax_, modEnvelopeOutMax_}); }
 }
 
 } // namespace Uhhyou
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../parameter.hpp"
+#include "Uhhyou/dsp/basiclimiter.hpp"
 #include "Uhhyou/dsp/multirate.hpp"
 #include "Uhhyou/dsp/smoother.hpp"
 #include "transientshaper.hpp"
@@ -33,13 +34,23 @@ public:
   void process(const size_t length, const float* in0, const float* in1, float* out0, float* out1);
 
 private:
-  void updateUpRate();
-  std::array<double, 2> processSample(const std::array<double, 2> in);
+  using Frame = std::array<double, nChannel>;
 
+  // Detector parameters are updated once per block of `blockSize` input samples.
+  static constexpr size_t blockSize = 64;
   static constexpr unsigned upFold = 2;
+  static constexpr size_t upBlockSize = upFold * blockSize;
+  static constexpr double lookaheadSecond = double(0.001);
+
+  void updateUpRate();
+  void updateLookahead();
+  void processBlock(const size_t length, const float* in0, const float* in1, float* out0,
+                    float* out1);
+
   unsigned overSampling_ = 2;
   double sampleRate_ = 44100;
   double upRate_ = upFold * 44100.0;
+  size_t lookaheadFrames_ = 0; // In input sample rate.
 
   std::array<float, 2> inputPeakMax_{};
   std::array<float, 2> modEnvelopeOutMax_{};
@@ -54,12 +65,22 @@ private:
   ExpSmoother<double> lowGain_{smoo_};
   ExpSmoother<double> highGain_{smoo_};
 
-  std::array<BandSplitter<double, 63>, 2> splitter_;
-  std::array<EnvelopeFollowerExpDecay<double>, 2> envelopeHigh_;
-  std::array<Butterworth<double, 8>, 2> lowpass_;
+  SincLowpassKernel<double, 63> splitterKernel_;
+  BandSplitter<double, 63, nChannel> splitter_;
+  EnvelopeFollowerExpDecay<double, nChannel> envelopeHigh_;
+  Butterworth<double, 8, nChannel> lowpass_;
+  IntDelay<std::array<Frame, 2>> bandDelay_; // `[0]` is low band, and `[1]` is high band.
 
-  std::array<std::array<double, 2>, 2> halfbandInput_{};
+  Frame previousInput_{};
   std::array<HalfBandIIR<double, HalfBandCoefficient<double>>, 2> halfbandIir_;
+
+  // Buffers of a block in upsampled rate.
+  std::array<Frame, upBlockSize> lowBuffer_{};
+  std::array<Frame, upBlockSize> highBuffer_{};
+  std::array<Frame, upBlockSize> envelopeBuffer_{};
+  std::array<double, upBlockSize> intensityBuffer_{};
+  std::array<double, upBlockSize> lowGainBuffer_{};
+  std::array<double, upBlockSize> highGainBuffer_{};
 };
 
 } // namespace Uhhyou
@@ -23,29 +23,34 @@ template<typename Sample> struct SplittedBand2 {
   inline Sample sum() { return low + high; }
 };
 
-template<typename Sample, size_t length = 63> class BandSplitter {
+/*
+Half of symmetric windowless sinc lowpass kernel, shared by `BandSplitter` of all channels. `tap[i]`
+is the coefficient at `i - latency`, for `i` in `[0, latency]`.
+
+Kernel is only rebuilt when cutoff moves more than `tolerance`. Otherwise the rebuild runs on every
+sample, because `ExpSmoother` approaches its target asymptotically.
+*/
+template<typename Sample, size_t length = 63> class SincLowpassKernel {
 private:
-  static_assert(length > 0, "Length must be greater than zero");
+  static_assert(length % 2 == 1, "Length must be odd to make the kernel symmetric");
 
-  size_t wptr_ = 0;
-  std::array<Sample, length> buf_{};
-
-public:
-  static constexpr size_t latency = length / 2;
+  static constexpr Sample tolerance = Sample(1e-12);
 
-  void reset() {
-    wptr_ = 0;
-    buf_.fill({});
-  }
+  // `1 / (pi * x)` for `x` in `[-latency, 0)`.
+  static constexpr auto inversePiX = []() {
+    std::array<Sample, length / 2> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+      table[i] = Sample(1) / (std::numbers::pi_v<Sample> * (Sample(i) - Sample(length / 2)));
+    }
+    return table;
+  }();
 
-  SplittedBand2<Sample> process(Sample input, Sample cutoffNormalized) {
-    if constexpr (length == 1) { return {Sample(2) * cutoffNormalized * input, Sample(0)}; }
+  Sample cutoff_ = -1;
 
-    // Write to buffer.
-    if (++wptr_ >= length) { wptr_ = 0; }
-    buf_[wptr_] = input;
+  void build(Sample cutoffNormalized) {
+    cutoff_ = cutoffNormalized;
 
-    // Setup recursive sine oscillator.
+    // Recursive sine oscillator.
     constexpr Sample pi = std::numbers::pi_v<Sample>;
     const Sample omega = Sample(2) * pi * cutoffNormalized;
     const Sample phi = -Sample(latency) * omega;
@@ -53,45 +58,116 @@ public:
     Sample u1 = std::sin(phi - omega);
     Sample u2 = std::sin(phi - Sample(2) * omega);
 
-    // Convolution.
-    size_t rptr = wptr_;
-    Sample sum = 0;
-    for (size_t i = 0; i < length; ++i) {
+    for (size_t i = 0; i < latency; ++i) {
       const Sample u0 = k * u1 - u2;
       u2 = u1;
       u1 = u0;
+      tap[i] = u0 * inversePiX[i];
+    }
+    tap[latency] = Sample(2) * cutoffNormalized;
+  }
+
+public:
+  static constexpr size_t latency = length / 2;
+
+  alignas(32) std::array<Sample, latency + 1> tap{};
+
+  void reset(Sample cutoffNormalized) { build(cutoffNormalized); }
+
+  void update(Sample cutoffNormalized) {
+    if (std::abs(cutoffNormalized - cutoff_) <= tolerance) { return; }
+    build(cutoffNormalized);
+  }
+};
+
+/*
+Linear phase 2-band splitter. Each of `nLane` is an independent signal filtered by the same
+`SincLowpassKernel`. Input history is mirrored, so that the window of latest `length` samples is
+always contiguous. Symmetry of the kernel is used to fold the window, which halves multiplications.
+*/
+template<typename Sample, size_t length = 63, size_t nLane = 1> class BandSplitter {
+public:
+  using Kernel = SincLowpassKernel<Sample, length>;
+  using Lane = std::array<Sample, nLane>;
+
+private:
+  size_t wptr_ = 0;
+  std::array<Lane, 2 * length> buf_{};
 
-      const Sample x = Sample(i) - Sample(latency);
-      const Sample sinc = x == 0 ? Sample(2) * cutoffNormalized : u0 / (pi * x);
+public:
+  static constexpr size_t latency = Kernel::latency;
+
+  void reset() {
+    wptr_ = 0;
+    buf_.fill({});
+  }
+
+  SplittedBand2<Lane> process(const Lane& input, const Kernel& kernel) {
+    // Write to buffer. `window[length - 1]` is the latest input.
+    if (++wptr_ >= length) { wptr_ = 0; }
+    buf_[wptr_] = input;
+    buf_[wptr_ + length] = input;
+    const Lane* window = buf_.data() + wptr_ + 1;
 
-      if (++rptr >= length) { rptr = 0; }
-      sum += sinc * buf_[rptr];
+    // Convolution.
+    const auto& tap = kernel.tap;
+    Lane low;
+    for (size_t n = 0; n < nLane; ++n) { low[n] = tap[latency] * window[latency][n]; }
+    for (size_t i = 0; i < latency; ++i) {
+      const Lane& front = window[i];
+      const Lane& back = window[length - 1 - i];
+      for (size_t n = 0; n < nLane; ++n) { low[n] += tap[i] * (front[n] + back[n]); }
     }
 
-    size_t center = (wptr_ >= latency) ? (wptr_ - latency) : (wptr_ + length - latency);
-    return {sum, buf_[center] - sum};
+    Lane high;
+    for (size_t n = 0; n < nLane; ++n) { high[n] = window[latency][n] - low[n]; }
+    return {low, high};
+  }
+
+  SplittedBand2<Sample> process(Sample input, const Kernel& kernel)
+    requires(nLane == 1)
+  {
+    const auto band = process(Lane{input}, kernel);
+    return {band.low[0], band.high[0]};
   }
 };
 
-template<typename Sample> class EnvelopeFollowerExpDecay {
+/*
+Peak hold with exponential decay. `decay` is a multiplier per sample from `decayFactor`, so that
+`exp` can be computed once per block instead of per sample.
+*/
+template<typename Sample, size_t nLane = 1> class EnvelopeFollowerExpDecay {
+public:
+  using Lane = std::array<Sample, nLane>;
+
 private:
-  Sample y_ = 0;
+  Lane y_{};
 
 public:
-  void reset() { y_ = 0; }
+  void reset() { y_.fill({}); }
 
-  Sample process(Sample input, Sample decayTimeSample, Sample refreshRatio) {
+  static Sample decayFactor(Sample decayTimeSample) {
     const Sample time = std::max(Sample(1), decayTimeSample);
 
     // `(1e-3)^(1/time)` but using `exp` instead of `pow`.
     // The magic number is `log(1e-3) ~= -6.907755278982137`.
-    const Sample decay = std::exp(Sample(-6.907755278982137) / time);
+    return std::exp(Sample(-6.907755278982137) / time);
+  }
 
-    y_ *= decay;
-    const Sample x = std::abs(input);
-    if (x >= refreshRatio * y_) { y_ = x; }
+  Lane process(const Lane& input, Sample decay, Sample refreshRatio) {
+    for (size_t n = 0; n < nLane; ++n) {
+      const Sample held = y_[n] * decay;
+      const Sample x = std::abs(input[n]);
+      y_[n] = x >= refreshRatio * held ? x : held;
+    }
     return y_;
   }
+
+  Sample process(Sample input, Sample decay, Sample refreshRatio)
+    requires(nLane == 1)
+  {
+    return process(Lane{input}, decay, refreshRatio)[0];
+  }
 };
 
 template<typename Sample> class EnvelopeFollowerEmaCascade {
@@ -123,15 +199,28 @@ public:
   }
 };
 
-template<typename Sample, size_t order = 2> class Butterworth {
+/*
+Cascade of 2nd order lowpass sections. Coefficients are only updated by `setCutoff`, which is
+intended to be called once per block.
+*/
+template<typename Sample, size_t order = 2, size_t nLane = 1> class Butterworth {
+public:
+  using Lane = std::array<Sample, nLane>;
+
 private:
   static_assert(order > 0 && order % 2 == 0);
   static constexpr size_t nSection = order / 2;
 
-  std::array<Sample, nSection> x1_{};
-  std::array<Sample, nSection> x2_{};
-  std::array<Sample, nSection> y1_{};
-  std::array<Sample, nSection> y2_{};
+  // `b2` equals to `b0`.
+  std::array<Sample, nSection> b0_{};
+  std::array<Sample, nSection> b1_{};
+  std::array<Sample, nSection> a1_{};
+  std::array<Sample, nSection> a2_{};
+
+  std::array<Lane, nSection> x1_{};
+  std::array<Lane, nSection> x2_{};
+  std::array<Lane, nSection> y1_{};
+  std::array<Lane, nSection> y2_{};
 
 public:
   void reset() {
@@ -141,38 +230,49 @@ public:
     y2_.fill({});
   }
 
-  Sample process(Sample x0, Sample cutoffNormalized) {
+  void setCutoff(Sample cutoffNormalized) {
     constexpr Sample pi = std::numbers::pi_v<Sample>;
 
     const Sample omega = Sample(2) * pi * std::clamp(cutoffNormalized, Sample(1e-6), Sample(0.499));
+    const Sample sn = std::sin(omega);
+    const Sample cs = std::cos(omega);
     for (size_t i = 0; i < nSection; ++i) {
       // const Sample Q = Sample(0.5) / std::sin(Sample(2 * idx + 1) * pi / Sample(order));
       const Sample Q = Sample(0.5) / std::cos(pi * Sample(i) / Sample(order));
 
-      const Sample sn = std::sin(omega);
-      const Sample cs = std::cos(omega);
-
       const Sample alpha = sn / (Sample(2) * Q);
       const Sample a0 = Sample(1) + alpha;
 
-      const Sample a1 = (Sample(2) * cs) / a0;
-      const Sample a2 = (alpha - Sample(1)) / a0;
+      a1_[i] = (Sample(2) * cs) / a0;
+      a2_[i] = (alpha - Sample(1)) / a0;
 
-      const Sample b1 = (Sample(1) - std::cos(omega)) / a0;
-      const Sample b0 = b1 / Sample(2);
-      const Sample& b2 = b0;
+      b1_[i] = (Sample(1) - cs) / a0;
+      b0_[i] = b1_[i] / Sample(2);
+    }
+  }
 
-      const Sample y0 = b0 * x0 + b1 * x1_[i] + b2 * x2_[i] + a1 * y1_[i] + a2 * y2_[i];
+  Lane process(Lane x0) {
+    for (size_t i = 0; i < nSection; ++i) {
+      for (size_t n = 0; n < nLane; ++n) {
+        const Sample y0 = b0_[i] * x0[n] + b1_[i] * x1_[i][n] + b0_[i] * x2_[i][n]
+          + a1_[i] * y1_[i][n] + a2_[i] * y2_[i][n];
 
-      x2_[i] = x1_[i];
-      x1_[i] = x0;
-      y2_[i] = y1_[i];
-      y1_[i] = y0;
+        x2_[i][n] = x1_[i][n];
+        x1_[i][n] = x0[n];
+        y2_[i][n] = y1_[i][n];
+        y1_[i][n] = y0;
 
-      x0 = y0;
+        x0[n] = y0;
+      }
     }
     return x0;
   }
+
+  Sample process(Sample x0)
+    requires(nLane == 1)
+  {
+    return process(Lane{x0})[0];
+  }
 };
 
 } // namespace Uhhyou
@@ -8,6 +8,7 @@
 #include <juce_gui_extra/juce_gui_extra.h>
 
 #include "../parameter.hpp"
+#include "Uhhyou/gui/animationscheduler.hpp"
 #include "Uhhyou/gui/style.hpp"
 
 #include <algorithm>
@@ -15,33 +16,33 @@
 #include <cmath>
 #include <deque>
 #include <limits>
+#include <utility>
 
 namespace Uhhyou {
 
-class EnvelopeDisplay : public juce::AnimatedAppComponent {
+class EnvelopeDisplay : public AnimatedComponent {
 private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EnvelopeDisplay)
 
 protected:
   Palette& pal_;
-  std::array<std::atomic<float>, nChannel>& meterInput_;
-  std::array<std::atomic<float>, nChannel>& meterEnvelope_;
+
+  // Maximum since last `update`.
+  std::array<float, nChannel> meterInput_{};
+  std::array<float, nChannel> meterEnvelope_{};
 
   bool isMouseEntered_ = false;
   juce::Font font_;
   juce::PathStrokeType lineStrokeType_;
   std::array<std::deque<float>, nChannel> inPeak_;
   std::array<std::deque<float>, nChannel> envelope_;
+  size_t settleFrames_ = 0; // Lines are flat when this reaches 0.
 
 public:
-  EnvelopeDisplay(juce::Component& parent, Palette& palette,
-                  std::array<std::atomic<float>, nChannel>& meterInput,
-                  std::array<std::atomic<float>, nChannel>& meterEnvelope)
-      : pal_(palette), meterInput_(meterInput), meterEnvelope_(meterEnvelope),
-        font_(palette.getFont(TextSize::normal)),
+  EnvelopeDisplay(juce::Component& parent, Palette& palette)
+      : pal_(palette), font_(palette.getFont(TextSize::normal)),
         lineStrokeType_(palette.borderWidth(), juce::PathStrokeType::JointStyle::curved,
                         juce::PathStrokeType::EndCapStyle::rounded) {
-    setSynchroniseToVBlank(true);
     parent.addAndMakeVisible(*this, 0);
   }
 
@@ -54,21 +55,39 @@ public:
     const auto size = size_t(getWidth() - 2 * pal_.borderWidth());
     for (auto& x : inPeak_) { x.resize(size, float(1)); }
     for (auto& x : envelope_) { x.resize(size, float(1)); }
+    settleFrames_ = size;
+  }
+
+  void push(const DisplayRecord& record) {
+    for (size_t i = 0; i < nChannel; ++i) {
+      meterInput_[i] = std::max(meterInput_[i], record.inputPeak[i]);
+      meterEnvelope_[i] = std::max(meterEnvelope_[i], record.envelopePeak[i]);
+    }
   }
 
-  virtual void update() override {
+  virtual bool advance(int) override {
+    bool isMoved = false;
+    auto scroll = [&](std::deque<float>& line, float value) {
+      if (line.empty()) { return; }
+      isMoved |= line.back() != value;
+      line.push_back(value);
+      line.pop_front();
+    };
+
     for (size_t i = 0; i < inPeak_.size(); ++i) {
-      inPeak_[i].push_back(float(1) - meterInput_[i].load());
-      inPeak_[i].pop_front();
+      scroll(inPeak_[i], float(1) - std::exchange(meterInput_[i], float(0)));
     }
 
     for (size_t i = 0; i < envelope_.size(); ++i) {
-      envelope_[i].push_back(float(1) - meterEnvelope_[i].load());
-      envelope_[i].pop_front();
+      scroll(envelope_[i], float(1) - std::exchange(meterEnvelope_[i], float(0)));
     }
+
+    const size_t length = inPeak_[0].size();
+    settleFrames_ = isMoved ? length : settleFrames_ - size_t(settleFrames_ > 0);
+    return settleFrames_ > 0;
   }
 
-  virtual void paint(juce::Graphics& ctx) override {
+  virtual void paintFrame(juce::Graphics& ctx) override {
     const float lw1 = pal_.borderWidth(); // Border width.
     const float lw2 = 2 * lw1;
     const float lwHalf = lw1 / 2;
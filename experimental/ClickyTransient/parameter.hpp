@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "Uhhyou/dsp/telemetry.hpp"
 #include "Uhhyou/scale.hpp"
 #include "Uhhyou/scaledparameter.hpp"
 
@@ -36,6 +37,12 @@ struct Scales {
   DecibelScl refreshRatio{float(-40), float(40), false};
 };
 
+// Values of a processing block sent to GUI.
+struct DisplayRecord {
+  std::array<float, nChannel> inputPeak{};
+  std::array<float, nChannel> envelopePeak{};
+};
+
 struct ValueReceivers {
   std::atomic<float>* lowGain{};
   std::atomic<float>* highGain{};
@@ -45,10 +52,10 @@ struct ValueReceivers {
   std::atomic<float>* shaperRefreshRatio{};
   std::atomic<float>* shaperIntensity{};
   std::atomic<float>* shaperPostLowpassHz{};
+  std::atomic<float>* lookahead{};
 
   // Internal values used for GUI.
-  std::array<std::atomic<float>, nChannel> inputPeakMax{float(0), float(0)};
-  std::array<std::atomic<float>, nChannel> modEnvelopeOutMax{float(0), float(0)};
+  TelemetryRing<DisplayRecord, 512> displayTelemetry;
 };
 
 class ParameterStore {
@@ -122,6 +129,11 @@ private:
                      std::make_unique<ScaledParameter<Scales::UIntScl>>(
                        scale.boolean.invmap(0), scale.boolean, "oversampling", "2x Sampling",
                        Cat::genericParameter, version, "", Rep::raw));
+    value.lookahead
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::UIntScl>>(
+                       scale.boolean.invmap(0), scale.boolean, "lookahead", "Lookahead",
+                       Cat::genericParameter, version, "", Rep::raw));
 
     layout.add(std::move(generalGroup));
     return layout;
@@ -20,7 +20,7 @@ struct Metrics {
   int labelY = labelH + 2 * margin;
   int sectionWidth = 2 * labelW + 2 * margin;
   int totalWidth = 2 * sectionWidth + 3 * uiMargin;
-  int totalHeight = 17 * labelY + labelH + 2 * uiMargin;
+  int totalHeight = 18 * labelY + labelH + 2 * uiMargin;
 
   Metrics() = default;
 
@@ -69,6 +69,7 @@ Editor::Editor(Processor& proc)
   addTextKnob(sAsym, "asymExponentRange", sc.asymExponentRange, {}, 5);
 
   addToggleButton(sLimiter, "limiterEnabled", sc.boolean, "", "", LabeledWidget::expand);
+  addToggleButton(sLimiter, "limiterStereoLink", sc.boolean, "", "", LabeledWidget::expand);
   addTextKnob(sLimiter, "limiterInputGain", sc.gain, {}, 5);
   addTextKnob(sLimiter, "limiterReleaseSecond", sc.envelopeSecond, {}, 5);
 
@@ -118,8 +119,9 @@ void Editor::resized() {
   layoutActionSectionAndPluginInfo(left1, currentTop, mt.sectionWidth, mt.labelW, mt.labelX,
                                    mt.labelH, mt.labelY);
 
-  statusBar_.setBounds(
-    Rect{left0, bottom - mt.labelH - mt.uiMargin, mt.totalWidth - 2 * mt.uiMargin, mt.labelH});
+  layoutStatusBar(
+    Rect{left0, bottom - mt.labelH - mt.uiMargin, mt.totalWidth - 2 * mt.uiMargin, mt.labelH},
+    mt.margin, mt.labelW);
 }
 
 } // namespace Uhhyou
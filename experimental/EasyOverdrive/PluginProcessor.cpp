@@ -8,9 +8,11 @@ Processor::Processor()
     : AudioProcessor(BusesProperties()
                        .withInput("Input", juce::AudioChannelSet::stereo(), true)
                        .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      param(*this, &undoManager, juce::Identifier("Root")), dsp(param) {}
+      param(*this, &undoManager, juce::Identifier("Root")), dsp(param) {
+  startTimerHz(10);
+}
 
-Processor::~Processor() {}
+Processor::~Processor() { stopTimer(); }
 
 const juce::String Processor::getName() const { return JucePlugin_Name; }
 bool Processor::acceptsMidi() const { return true; }
@@ -35,6 +37,19 @@ void Processor::prepareToPlay(double sampleRate, int) {
   previousSampleRate = sampleRate;
 }
 
+// Grows DSP buffers requested by the audio thread. Lock isn't used, so `processBlock` keeps running
+// at previous oversampling until it swaps in the new buffers. When rendering offline, the message
+// thread may not be running, so buffers are grown in `processBlock` instead.
+//
+// Oversampling changes on the audio thread after growing buffers, so the latency set by parameter
+// callbacks may be outdated. It's corrected here to the one actually running.
+void Processor::timerCallback() {
+  if (!isNonRealtime()) { dsp.growBuffers(); }
+
+  const int latency = int(dsp.getLatency());
+  if (latency != getLatencySamples()) { setLatencySamples(latency); }
+}
+
 void Processor::releaseResources() {}
 void Processor::reset() { dsp.reset(); }
 
@@ -61,6 +76,7 @@ void Processor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&
   }
 
   juce::ScopedNoDenormals noDenormals;
+  Uhhyou::LoadMeter::ScopedMeasure loadMeasure(loadMeter, buffer.getNumSamples(), getSampleRate());
 
   auto audioPlayHead = getPlayHead();
   if (audioPlayHead != nullptr) {
@@ -86,6 +102,7 @@ void Processor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&
     buffer.clear(i, 0, buffer.getNumSamples());
   }
 
+  if (isNonRealtime()) { dsp.growBuffers(); }
   dsp.setParameters();
 
   auto in0 = buffer.getReadPointer(0);
@@ -7,12 +7,13 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_data_structures/juce_data_structures.h>
 
+#include "Uhhyou/dsp/loadmeter.hpp"
 #include "dsp/dspcore.hpp"
 #include "parameter.hpp"
 
 #include <mutex>
 
-class Processor final : public juce::AudioProcessor {
+class Processor final : public juce::AudioProcessor, private juce::Timer {
 public:
   Processor();
   ~Processor() override;
@@ -45,15 +46,21 @@ public:
   void getStateInformation(juce::MemoryBlock& destData) override;
   void setStateInformation(const void* data, int sizeInBytes) override;
 
+  // Bytes used by this instance, including buffers of `dsp`.
+  size_t getMemoryFootprint() const { return sizeof(Processor) + dsp.getBufferBytes(); }
+
 public:
   juce::UndoManager undoManager{32768, 512};
 
   Uhhyou::ParameterStore param;
   Uhhyou::DSPCore dsp;
+  Uhhyou::LoadMeter loadMeter;
   double previousSampleRate = double(-1);
 
 private:
   std::mutex setupMutex_;
 
+  void timerCallback() override;
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Processor)
 };
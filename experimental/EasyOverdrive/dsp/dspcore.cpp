@@ -16,23 +16,101 @@ constexpr double limiterAttackSecond = 0.001;
 void DSPCore::setup(double sampleRate) {
   sampleRate_ = double(sampleRate);
 
-  auto maxRate = upFold * sampleRate_;
-  for (auto& x : overDrive_) {
-    x.resize(size_t(maxRate * param.scale.overDriveHoldSecond.getMax()) + 1);
-  }
-  for (auto& x : limiter_) { x.resize(size_t(maxRate * limiterAttackSecond) + 1); }
+  // `process` is stopped here, so buffers are directly resized. Buffers may shrink only here.
+  grownBuffers_.reset();
+  growState_.store(GrowState::idle, std::memory_order_relaxed);
+  bufferGrowRequested_.store(false, std::memory_order_relaxed);
+
+  auto& pv = param.value;
+  const size_t oversampling = size_t(pv.oversampling->load());
+  limiterCapacity_ = requiredLimiterFrames(oversampling);
+  for (auto& x : limiter_) { x.resize(limiterCapacity_); }
+  linkedLimiter_.resize(limiterCapacity_);
+  holdCapacity_ = requiredHoldFrames(oversampling, pv.overDriveHoldSecond->load());
+  for (auto& x : overDrive_) { x.resize(holdCapacity_); }
+  updateBufferBytes();
 
   reset();
   startup();
 }
 
+size_t DSPCore::requiredLimiterFrames(size_t oversampling) {
+  return size_t(sampleRate_ * fold[oversampling] * limiterAttackSecond) + 1;
+}
+
+size_t DSPCore::requiredHoldFrames(size_t oversampling, double holdSecond) {
+  return size_t(sampleRate_ * fold[oversampling] * holdSecond) + 1;
+}
+
+void DSPCore::growBuffers() {
+  const auto state = growState_.load(std::memory_order_acquire);
+  if (state == GrowState::ready) { return; } // Not yet taken by audio thread.
+  if (state == GrowState::swapped) {
+    grownBuffers_.reset();
+    growState_.store(GrowState::idle, std::memory_order_relaxed);
+  }
+
+  if (!bufferGrowRequested_.exchange(false, std::memory_order_relaxed)) { return; }
+
+  auto& pv = param.value;
+  const size_t oversampling = size_t(pv.oversampling->load());
+  auto grown = std::make_unique<GrownBuffers>();
+
+  const size_t limiterFrames = requiredLimiterFrames(oversampling);
+  if (limiterFrames > limiterCapacity_) {
+    grown->limiterFrames = limiterFrames;
+    for (auto& x : grown->limiter) { x.resize(limiterFrames); }
+    grown->linkedLimiter.resize(limiterFrames);
+  }
+
+  const size_t holdFrames = requiredHoldFrames(oversampling, pv.overDriveHoldSecond->load());
+  if (holdFrames > holdCapacity_) {
+    // At least doubled, so that turning the hold knob doesn't resize on each step.
+    const size_t maxFrames
+      = requiredHoldFrames(oversampling, param.scale.overDriveHoldSecond.getMax());
+    grown->holdFrames = std::min(std::max(holdFrames, 2 * holdCapacity_), maxFrames);
+    for (auto& x : grown->hold) { x.resize(Delay<double>::bufferSize(grown->holdFrames)); }
+  }
+
+  if (grown->limiterFrames == 0 && grown->holdFrames == 0) { return; }
+  grownBuffers_ = std::move(grown);
+  growState_.store(GrowState::ready, std::memory_order_release);
+}
+
+// Called on audio thread. Only pointers are exchanged, and hold buffers are copied.
+void DSPCore::swapGrownBuffers() {
+  if (growState_.load(std::memory_order_acquire) != GrowState::ready) { return; }
+
+  auto& grown = *grownBuffers_;
+  if (grown.limiterFrames > limiterCapacity_) {
+    // New limiters are reset by `prepare` in `setParameters`, as their attack time is 0.
+    std::swap(limiter_, grown.limiter);
+    std::swap(linkedLimiter_, grown.linkedLimiter);
+    limiterCapacity_ = grown.limiterFrames;
+  }
+  if (grown.holdFrames > holdCapacity_) {
+    for (size_t ch = 0; ch < overDrive_.size(); ++ch) { overDrive_[ch].swapBuffer(grown.hold[ch]); }
+    holdCapacity_ = grown.holdFrames;
+  }
+  updateBufferBytes();
+
+  growState_.store(GrowState::swapped, std::memory_order_release);
+}
+
+void DSPCore::updateBufferBytes() {
+  size_t bytes = linkedLimiter_.bufferBytes();
+  for (const auto& x : limiter_) { bytes += x.bufferBytes(); }
+  for (const auto& x : overDrive_) { bytes += x.bufferBytes(); }
+  bufferBytes_.store(bytes, std::memory_order_relaxed);
+}
+
 size_t DSPCore::getLatency() {
   auto& pv = param.value;
 
   size_t latency = 2; // Fixed 2 samples from CubicUpSampler.
 
   if (pv.limiterEnabled->load() != 0) {
-    latency += limiter_[0].latency(fold[size_t(pv.oversampling->load())]);
+    latency += limiter_[0].latency(activeFold_.load(std::memory_order_relaxed));
   }
 
   return latency;
@@ -45,7 +123,10 @@ size_t DSPCore::getLatency() {
                                                                                                    \
   overDriveType_ = size_t(pv.overDriveType->load());                                               \
   asymDriveEnabled_ = (pv.asymDriveEnabled->load()) != 0;                                          \
-  limiterEnabled_ = (pv.limiterEnabled->load()) != 0;                                              \
+  limiterMode_ = pv.limiterEnabled->load() == 0 ? LimiterMode::Bypass                              \
+    : pv.limiterStereoLink->load() == 0         ? LimiterMode::Unlinked                            \
+                                                : LimiterMode::Linked;                             \
+  selectBlockKernel();                                                                             \
                                                                                                    \
   preDriveGain_.METHOD(pv.preDriveGain->load());                                                   \
   postDriveGain_.METHOD(pv.postDriveGain->load());                                                 \
@@ -63,17 +144,38 @@ size_t DSPCore::getLatency() {
                                                                                                    \
   for (auto& x : limiter_) {                                                                       \
     x.prepare(upRate_, limiterAttackSecond, pv.limiterReleaseSecond->load(), double(1));           \
-  }
+  }                                                                                                \
+  linkedLimiter_.prepare(upRate_, limiterAttackSecond, pv.limiterReleaseSecond->load(), double(1));
+
+void DSPCore::updateUpRate() {
+  upRate_ = double(sampleRate_) * fold[oversampling_];
+  activeFold_.store(fold[oversampling_], std::memory_order_relaxed);
+}
 
-void DSPCore::updateUpRate() { upRate_ = double(sampleRate_) * fold[oversampling_]; }
+// `BadLimiter` clamps the delay time to the buffer, so only the limiter blocks the change.
+void DSPCore::updateOversampling() {
+  auto& pv = param.value;
+  const size_t newOversampling = size_t(pv.oversampling->load());
+
+  const bool isLimiterFit = requiredLimiterFrames(newOversampling) <= limiterCapacity_;
+  const bool isHoldFit
+    = requiredHoldFrames(newOversampling, pv.overDriveHoldSecond->load()) <= holdCapacity_;
+  if (!isLimiterFit || !isHoldFit) { bufferGrowRequested_.store(true, std::memory_order_relaxed); }
+
+  if (isLimiterFit && oversampling_ != newOversampling) {
+    oversampling_ = newOversampling;
+    updateUpRate();
+  }
+}
 
 void DSPCore::reset() {
-  oversampling_ = size_t(param.value.oversampling->load());
+  updateOversampling();
   updateUpRate();
 
   ASSIGN_PARAMETER(reset);
 
   for (auto& x : limiter_) { x.reset(); }
+  linkedLimiter_.reset();
   for (auto& x : upSampler_) { x.reset(); }
   for (auto& x : decimationLowpass_) { x.reset(); }
   for (auto& x : halfbandIir_) { x.reset(); }
@@ -84,16 +186,26 @@ void DSPCore::reset() {
 void DSPCore::startup() {}
 
 void DSPCore::setParameters() {
-  size_t newOversampling = size_t(param.value.oversampling->load());
-  if (oversampling_ != newOversampling) {
-    oversampling_ = newOversampling;
-    updateUpRate();
-  }
+  swapGrownBuffers();
+  updateOversampling();
+
+  const size_t previousLimiterMode = limiterMode_;
 
   ASSIGN_PARAMETER(push);
+
+  // Only the limiter of current mode is processed. The other one is left with the gain and delay of
+  // the time it was used, so it's reset to not output the stale state.
+  if (limiterMode_ != previousLimiterMode) {
+    if (limiterMode_ == LimiterMode::Unlinked) {
+      for (auto& x : limiter_) { x.reset(); }
+    } else if (limiterMode_ == LimiterMode::Linked) {
+      linkedLimiter_.reset();
+    }
+  }
 }
 
-std::array<double, 2> DSPCore::processFrame(const std::array<double, 2>& frame) {
+template<size_t driveType, bool asymDrive, size_t limiterMode>
+inline std::array<double, 2> DSPCore::processFrame(const std::array<double, 2>& frame) {
   preDriveGain_.process();
   limiterInputGain_.process();
   postDriveGain_.process();
@@ -101,57 +213,45 @@ std::array<double, 2> DSPCore::processFrame(const std::array<double, 2>& frame)
   auto sig0 = preDriveGain_.value() * frame[0];
   auto sig1 = preDriveGain_.value() * frame[1];
 
-  switch (overDriveType_) {
-    default:
-    case BadLimiterType::Immediate: {
-      sig0 = overDrive_[0].processImmediate(sig0);
-      sig1 = overDrive_[1].processImmediate(sig1);
-    } break;
-
-    case BadLimiterType::HardGate: {
-      sig0 = overDrive_[0].processHardGate(sig0);
-      sig1 = overDrive_[1].processHardGate(sig1);
-    } break;
-
-    case BadLimiterType::Spike: {
-      sig0 = overDrive_[0].processSpike(sig0);
-      sig1 = overDrive_[1].processSpike(sig1);
-    } break;
-
-    case BadLimiterType::SpikeCubic: {
-      sig0 = overDrive_[0].processSpikeCubic(sig0);
-      sig1 = overDrive_[1].processSpikeCubic(sig1);
-    } break;
-
-    case BadLimiterType::CutoffMod: {
-      sig0 = overDrive_[0].processCutoffMod(sig0);
-      sig1 = overDrive_[1].processCutoffMod(sig1);
-    } break;
-
-    case BadLimiterType::Matched: {
-      sig0 = overDrive_[0].processMatched(sig0);
-      sig1 = overDrive_[1].processMatched(sig1);
-    } break;
-
-    case BadLimiterType::BadLimiter: {
-      sig0 = overDrive_[0].processBadLimiter(sig0);
-      sig1 = overDrive_[1].processBadLimiter(sig1);
-    } break;
-
-    case BadLimiterType::PolyDrive: {
-      sig0 = overDrive_[0].processPolyDrive(sig0);
-      sig1 = overDrive_[1].processPolyDrive(sig1);
-    } break;
+  if constexpr (driveType == BadLimiterType::HardGate) {
+    sig0 = overDrive_[0].processHardGate(sig0);
+    sig1 = overDrive_[1].processHardGate(sig1);
+  } else if constexpr (driveType == BadLimiterType::Spike) {
+    sig0 = overDrive_[0].processSpike(sig0);
+    sig1 = overDrive_[1].processSpike(sig1);
+  } else if constexpr (driveType == BadLimiterType::SpikeCubic) {
+    sig0 = overDrive_[0].processSpikeCubic(sig0);
+    sig1 = overDrive_[1].processSpikeCubic(sig1);
+  } else if constexpr (driveType == BadLimiterType::CutoffMod) {
+    sig0 = overDrive_[0].processCutoffMod(sig0);
+    sig1 = overDrive_[1].processCutoffMod(sig1);
+  } else if constexpr (driveType == BadLimiterType::Matched) {
+    sig0 = overDrive_[0].processMatched(sig0);
+    sig1 = overDrive_[1].processMatched(sig1);
+  } else if constexpr (driveType == BadLimiterType::BadLimiter) {
+    sig0 = overDrive_[0].processBadLimiter(sig0);
+    sig1 = overDrive_[1].processBadLimiter(sig1);
+  } else if constexpr (driveType == BadLimiterType::PolyDrive) {
+    sig0 = overDrive_[0].processPolyDrive(sig0);
+    sig1 = overDrive_[1].processPolyDrive(sig1);
+  } else {
+    sig0 = overDrive_[0].processImmediate(sig0);
+    sig1 = overDrive_[1].processImmediate(sig1);
   }
 
-  if (asymDriveEnabled_) {
+  if constexpr (asymDrive) {
     sig0 = asymDrive_[0].process(sig0);
     sig1 = asymDrive_[1].process(sig1);
   }
 
-  if (limiterEnabled_) {
+  if constexpr (limiterMode == LimiterMode::Unlinked) {
     sig0 = limiter_[0].process(sig0 * limiterInputGain_.value());
     sig1 = limiter_[1].process(sig1 * limiterInputGain_.value());
+  } else if constexpr (limiterMode == LimiterMode::Linked) {
+    auto limited = linkedLimiter_.process(
+      {sig0 * limiterInputGain_.value(), sig1 * limiterInputGain_.value()});
+    sig0 = limited[0];
+    sig1 = limited[1];
   }
 
   sig0 *= postDriveGain_.value();
@@ -160,15 +260,17 @@ std::array<double, 2> DSPCore::processFrame(const std::array<double, 2>& frame)
   return {sig0, sig1};
 }
 
-void DSPCore::process(const size_t length, const float* in0, const float* in1, float* out0,
-                      float* out1) {
-  for (size_t i = 0; i < length; ++i) {
-    upSampler_[0].process(in0[i]);
-    upSampler_[1].process(in1[i]);
+template<size_t driveType, bool asymDrive, size_t limiterMode>
+void DSPCore::processBlock(const size_t length, const float* in0, const float* in1, float* out0,
+                           float* out1) {
+  if (oversampling_ == 2) { // 16x.
+    for (size_t i = 0; i < length; ++i) {
+      upSampler_[0].process(in0[i]);
+      upSampler_[1].process(in1[i]);
 
-    if (oversampling_ == 2) { // 16x.
       for (size_t j = 0; j < upFold; ++j) {
-        auto frame = processFrame({upSampler_[0].output[j], upSampler_[1].output[j]});
+        auto frame = processFrame<driveType, asymDrive, limiterMode>(
+          {upSampler_[0].output[j], upSampler_[1].output[j]});
         decimationLowpass_[0].push(frame[0]);
         decimationLowpass_[1].push(frame[1]);
         upSampler_[0].output[j] = decimationLowpass_[0].output();
@@ -178,10 +280,16 @@ void DSPCore::process(const size_t length, const float* in0, const float* in1, f
         halfbandIir_[0].process({upSampler_[0].output[0], upSampler_[0].output[upFold / 2]}));
       out1[i] = float(
         halfbandIir_[1].process({upSampler_[1].output[0], upSampler_[1].output[upFold / 2]}));
-    } else if (oversampling_ == 1) { // 2x.
-      const size_t mid = upFold / 2;
+    }
+  } else if (oversampling_ == 1) { // 2x.
+    const size_t mid = upFold / 2;
+    for (size_t i = 0; i < length; ++i) {
+      upSampler_[0].process(in0[i]);
+      upSampler_[1].process(in1[i]);
+
       for (size_t j = 0; j < upFold; j += mid) {
-        auto frame = processFrame({upSampler_[0].output[j], upSampler_[1].output[j]});
+        auto frame = processFrame<driveType, asymDrive, limiterMode>(
+          {upSampler_[0].output[j], upSampler_[1].output[j]});
         upSampler_[0].output[j] = frame[0];
         upSampler_[1].output[j] = frame[1];
       }
@@ -189,12 +297,40 @@ void DSPCore::process(const size_t length, const float* in0, const float* in1, f
         = float(halfbandIir_[0].process({upSampler_[0].output[0], upSampler_[0].output[mid]}));
       out1[i]
         = float(halfbandIir_[1].process({upSampler_[1].output[0], upSampler_[1].output[mid]}));
-    } else { // 1x.
-      auto frame = processFrame({upSampler_[0].output[0], upSampler_[1].output[0]});
+    }
+  } else { // 1x.
+    for (size_t i = 0; i < length; ++i) {
+      upSampler_[0].process(in0[i]);
+      upSampler_[1].process(in1[i]);
+
+      auto frame = processFrame<driveType, asymDrive, limiterMode>(
+        {upSampler_[0].output[0], upSampler_[1].output[0]});
       out0[i] = float(frame[0]);
       out1[i] = float(frame[1]);
     }
   }
 }
 
+// Index is `(driveType * 2 + asymDrive) * LimiterMode::size + limiterMode`.
+template<size_t... index>
+constexpr std::array<DSPCore::BlockKernel, sizeof...(index)>
+DSPCore::makeBlockKernelTable(std::index_sequence<index...>) {
+  constexpr size_t nMode = LimiterMode::size;
+  return {&DSPCore::processBlock<index / (2 * nMode), (index / nMode) % 2 != 0, index % nMode>...};
+}
+
+void DSPCore::selectBlockKernel() {
+  static constexpr auto table
+    = makeBlockKernelTable(std::make_index_sequence<2 * LimiterMode::size * nOverDriveType>{});
+
+  const size_t driveType = overDriveType_ < nOverDriveType ? overDriveType_ : 0;
+  blockKernel_
+    = table[(2 * driveType + size_t(asymDriveEnabled_)) * LimiterMode::size + limiterMode_];
+}
+
+void DSPCore::process(const size_t length, const float* in0, const float* in1, float* out0,
+                      float* out1) {
+  (this->*blockKernel_)(length, in0, in1, out0, out1);
+}
+
 } // namespace Uhhyou
@@ -4,20 +4,28 @@
 #pragma once
 
 #include "../parameter.hpp"
-#include "./basiclimiter.hpp"
 #include "./overdrive.hpp"
+#include "Uhhyou/dsp/basiclimiter.hpp"
 #include "Uhhyou/dsp/multirate.hpp"
 #include "Uhhyou/dsp/smoother.hpp"
 
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <random>
+#include <utility>
+#include <vector>
 
 namespace Uhhyou {
 
+namespace LimiterMode {
+enum LimiterMode : size_t { Bypass, Unlinked, Linked, size };
+} // namespace LimiterMode
+
 class DSPCore {
 public:
-  DSPCore(ParameterStore& p) : param(p) {}
+  DSPCore(ParameterStore& p) : param(p) { selectBlockKernel(); }
 
   ParameterStore& param;
   bool isPlaying = false;
@@ -29,14 +37,47 @@ public:
   void setup(double sampleRate);
   void reset();
   void startup();
-  size_t getLatency();
+  size_t getLatency(); // Latency of the running oversampling, which may lag behind parameter.
   void setParameters();
   void process(const size_t length, const float* in0, const float* in1, float* out0, float* out1);
 
+  /*
+  Buffers are sized for current oversampling and hold time. When a parameter requires larger
+  buffers, audio thread keeps previous oversampling and clamps hold time, then raises a request.
+
+  `growBuffers` allocates larger buffers without locking, and `setParameters` swaps them in on the
+  next block. Previous buffers are freed on the next call of `growBuffers`. `growBuffers` must be
+  called from one thread. It may be the audio thread when rendering offline.
+  */
+  void growBuffers();
+  size_t getBufferBytes() const { return bufferBytes_.load(std::memory_order_relaxed); }
+
 private:
+  // Each combination of drive type, asymmetric drive, and limiter mode has its own block kernel, so
+  // the oversampled inner loop has no branch on parameters.
+  using BlockKernel = void (DSPCore::*)(const size_t, const float*, const float*, float*, float*);
+
+  static constexpr size_t nOverDriveType = BadLimiterType::PolyDrive + 1;
+
+  template<size_t... index>
+  static constexpr std::array<BlockKernel, sizeof...(index)>
+  makeBlockKernelTable(std::index_sequence<index...>);
+
   void updateUpRate();
+  void updateOversampling();
+  void swapGrownBuffers();
+  void updateBufferBytes();
+  size_t requiredLimiterFrames(size_t oversampling);
+  size_t requiredHoldFrames(size_t oversampling, double holdSecond);
+  void selectBlockKernel();
+
+  template<size_t driveType, bool asymDrive, size_t limiterMode>
   std::array<double, 2> processFrame(const std::array<double, 2>& frame);
 
+  template<size_t driveType, bool asymDrive, size_t limiterMode>
+  void processBlock(const size_t length, const float* in0, const float* in1, float* out0,
+                    float* out1);
+
   static constexpr size_t upFold = 16;
   static constexpr std::array<size_t, 3> fold{1, 2, upFold};
 
@@ -44,9 +85,29 @@ private:
   double upRate_ = upFold * 44100;
 
   size_t oversampling_ = 1;
+  std::atomic<size_t> activeFold_{fold[1]}; // Copy of `fold[oversampling_]` for `getLatency`.
+  size_t limiterCapacity_ = 0;
+  size_t holdCapacity_ = 0;
+  std::atomic<bool> bufferGrowRequested_{false};
+  std::atomic<size_t> bufferBytes_{0};
+
+  // `grownBuffers_` is owned by `growBuffers` while `idle` or `swapped`, and by the audio thread
+  // while `ready`. Capacities are only written on the audio thread before storing `swapped`.
+  enum class GrowState { idle, ready, swapped };
+  struct GrownBuffers {
+    size_t limiterFrames = 0; // 0 when limiters are not grown.
+    size_t holdFrames = 0;    // 0 when hold buffers are not grown.
+    std::array<BasicLimiter<double>, 2> limiter;
+    LinkedLimiter<double, 2> linkedLimiter;
+    std::array<std::vector<double>, 2> hold;
+  };
+  std::unique_ptr<GrownBuffers> grownBuffers_;
+  std::atomic<GrowState> growState_{GrowState::idle};
+
   size_t overDriveType_ = 0;
   bool asymDriveEnabled_ = true;
-  bool limiterEnabled_ = true;
+  size_t limiterMode_ = LimiterMode::Unlinked;
+  BlockKernel blockKernel_; // Selected in constructor, so `process` is valid before `reset`.
 
   SmootherParameter<double> smoo_;
   ExpSmoother<double> preDriveGain_{smoo_};
@@ -56,6 +117,7 @@ private:
   std::array<BadLimiter<double>, 2> overDrive_{{{smoo_}, {smoo_}}};
   std::array<AsymmetricDrive<double>, 2> asymDrive_{{{smoo_}, {smoo_}}};
   std::array<BasicLimiter<double>, 2> limiter_;
+  LinkedLimiter<double, 2> linkedLimiter_;
 
   std::array<CubicUpSampler<double, upFold>, 2> upSampler_;
   std::array<DecimationLowpass<double, Sos16FoldFirstStage<double>>, 2> decimationLowpass_;
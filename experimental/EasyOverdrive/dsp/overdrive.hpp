@@ -3,14 +3,17 @@
 
 #pragma once
 
-#include "./basiclimiter.hpp"
+#include "Uhhyou/dsp/basiclimiter.hpp"
+#include "Uhhyou/dsp/fastmath.hpp"
 #include "Uhhyou/dsp/smoother.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <numbers>
+#include <vector>
 
 namespace Uhhyou {
 
@@ -22,8 +25,8 @@ constexpr double maxFlatK
   = double(1) / (std::numbers::sqrt2_v<double> - std::numeric_limits<double>::epsilon());
 
 template<typename T> inline T freqToG(T normalizedFreq) {
-  return T(
-    std::tan(std::clamp(double(normalizedFreq), minCutoff, nyquist) * std::numbers::pi_v<double>));
+  return T(FastMath::tan(std::clamp(double(normalizedFreq), minCutoff, nyquist)
+                        * std::numbers::pi_v<double>));
 }
 
 template<typename T> inline T qToK(T Q) {
@@ -168,9 +171,30 @@ public:
   size_t wptr = 0;
   std::vector<Sample> buf;
 
+  static size_t bufferSize(size_t maxDelaySample) {
+    return maxDelaySample < 4 ? 4 : maxDelaySample + 1;
+  }
+
+  // Recent samples are kept, so that growing the buffer during playback doesn't click. When
+  // shrinking, the oldest samples are discarded.
   void resize(size_t maxDelaySample) {
-    buf.resize(maxDelaySample < 4 ? 4 : maxDelaySample + 1);
-    reset();
+    const size_t newSize = bufferSize(maxDelaySample);
+    std::rotate(buf.begin(), buf.begin() + std::ptrdiff_t(wptr), buf.end()); // Oldest first.
+    if (newSize < buf.size()) { buf.erase(buf.begin(), buf.end() - std::ptrdiff_t(newSize)); }
+    wptr = buf.size() % newSize;
+    buf.resize(newSize);
+  }
+
+  size_t bufferBytes() const { return buf.size() * sizeof(Sample); }
+
+  // Same as `resize` for growing, but `newBuf` is allocated by caller. Previous buffer is returned
+  // in `newBuf`, so this doesn't allocate nor free. `newBuf` must be zero filled.
+  void swapBuffer(std::vector<Sample>& newBuf) {
+    if (newBuf.size() <= buf.size()) { return; }
+    const auto mid = buf.begin() + std::ptrdiff_t(wptr);
+    std::copy(buf.begin(), mid, std::copy(mid, buf.end(), newBuf.begin())); // Oldest first.
+    wptr = buf.size();
+    buf.swap(newBuf);
   }
 
   void reset() { std::fill(buf.begin(), buf.end(), Sample(0)); }
@@ -234,6 +258,8 @@ public:
   // size_t latency(size_t upfold) { return attackFrames / upfold; }
 
   void resize(size_t maxDelaySample) { delay_.resize(maxDelaySample); }
+  void swapBuffer(std::vector<Sample>& newBuf) { delay_.swapBuffer(newBuf); }
+  size_t bufferBytes() const { return delay_.bufferBytes(); }
 
   void reset(Sample sampleRate, Sample holdSeconds, Sample Q, Sample characterAmp) {
     holdValue_ = 0;
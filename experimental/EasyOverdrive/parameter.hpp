@@ -56,6 +56,7 @@ struct ValueReceivers {
   std::atomic<float>* asymExponentRange{};
 
   std::atomic<float>* limiterEnabled{};
+  std::atomic<float>* limiterStereoLink{};
   std::atomic<float>* limiterInputGain{};
   std::atomic<float>* limiterReleaseSecond{};
 
@@ -155,6 +156,10 @@ private:
       generalGroup,
       std::make_unique<ScaledParameter<Scales::UIntScl>>(
         1.0f, scale.boolean, "limiterEnabled", "Enable", Cat::genericParameter, version0));
+    value.limiterStereoLink = addParameter(
+      generalGroup,
+      std::make_unique<ScaledParameter<Scales::UIntScl>>(
+        0.0f, scale.boolean, "limiterStereoLink", "Stereo Link", Cat::genericParameter, version0));
     value.limiterInputGain
       = addParameter(generalGroup,
                      std::make_unique<ScaledParameter<Scales::DecibelScl>>(
@@ -75,8 +75,9 @@ void Editor::resized() {
   layoutActionSectionAndPluginInfo(left1, top0, mt.sectionWidth, mt.labelW, mt.labelX, mt.labelH,
                                    mt.labelY);
 
-  statusBar_.setBounds(
-    Rect{left0, bottom - mt.labelH - mt.uiMargin, mt.totalWidth - 2 * mt.uiMargin, mt.labelH});
+  layoutStatusBar(
+    Rect{left0, bottom - mt.labelH - mt.uiMargin, mt.totalWidth - 2 * mt.uiMargin, mt.labelH},
+    mt.margin, mt.labelW);
 }
 
 } // namespace Uhhyou
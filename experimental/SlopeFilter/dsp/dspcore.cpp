@@ -27,12 +27,11 @@ size_t DSPCore::getLatency() { return 0; }
   const auto slopeDecibel = pv.slopeDecibel->load();                                               \
   const auto outputGain = pv.outputGain->load();                                                   \
   const bool isHighshelf = bool(pv.shelvingType->load());                                          \
-  for (auto& x : slopeFilter_) {                                                                   \
-    x.METHOD(sampleRate_, startHz, slopeDecibel, outputGain, isHighshelf);                         \
-  }
+  slopeCoefficient_.METHOD(sampleRate_, startHz, slopeDecibel, outputGain, isHighshelf);
 
 void DSPCore::reset() {
   ASSIGN_PARAMETER(reset);
+  for (auto& x : slopeFilter_) { x.reset(); }
   startup();
 }
 
@@ -42,10 +41,22 @@ void DSPCore::setParameters() { ASSIGN_PARAMETER(push); }
 
 void DSPCore::process(const size_t length, const float* in0, const float* in1, float* out0,
                       float* out1) {
+  auto& co = slopeCoefficient_;
+
+  if (!co.isSmoothing()) {
+    for (size_t i = 0; i < length; ++i) {
+      out0[i] = float(slopeFilter_[0].process(in0[i], co));
+      out1[i] = float(slopeFilter_[1].process(in1[i], co));
+    }
+    return;
+  }
+
   for (size_t i = 0; i < length; ++i) {
-    out0[i] = float(slopeFilter_[0].process(in0[i]));
-    out1[i] = float(slopeFilter_[1].process(in1[i]));
+    co.process();
+    out0[i] = float(slopeFilter_[0].process(in0[i], co));
+    out1[i] = float(slopeFilter_[1].process(in1[i], co));
   }
+  co.updateConvergence();
 }
 
 } // namespace Uhhyou
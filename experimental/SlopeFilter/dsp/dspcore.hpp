@@ -32,6 +32,7 @@ public:
 
 private:
   double sampleRate_ = 44100;
+  SlopeFilter<double, 12>::Coefficient slopeCoefficient_;
   std::array<SlopeFilter<double, 12>, 2> slopeFilter_;
 };
 
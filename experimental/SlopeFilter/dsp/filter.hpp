@@ -12,124 +12,302 @@
 namespace Uhhyou {
 
 /**
-1-pole matched high-shelving filter.
+Coefficients of 1-pole matched high-shelving filter. Returns `{b0, b1, -a1}`.
 
 Reference:
 - https://vicanek.de/articles/ShelvingFits.pdf
   - Martin Vicanek, "Matched One-Pole Digital Shelving Filters", revised 2019-09-24.
 */
-template<typename Sample> class MatchedHighShelf1 {
+template<typename Sample>
+inline std::array<Sample, 3> matchedHighShelf1(Sample cutoffNormalized, Sample gainAmp) {
+  using S = Sample;
+
+  constexpr S minCut = S(10.0 / 48000.0);
+  constexpr S maxCut = S(20000.0 / 44100.0);
+  if (cutoffNormalized < minCut) {
+    cutoffNormalized = minCut;
+    gainAmp = S(1);
+  } else if (cutoffNormalized > maxCut) {
+    cutoffNormalized = maxCut;
+    gainAmp = S(1);
+  }
+
+  constexpr S pi = std::numbers::pi_v<S>;
+  constexpr S phim = S(1.9510565162951536); // 1 - cos(pi * 0.9).
+  constexpr S pp = S(2) / (pi * pi);
+  constexpr S xi = pp / (phim * phim) - S(1) / phim;
+
+  const S fc2 = cutoffNormalized * cutoffNormalized / S(4);
+  S alpha = xi + pp / (gainAmp * fc2);
+  S beta = xi + pp * gainAmp / fc2;
+
+  S neg_a1 = alpha / (S(1) + alpha + std::sqrt(S(1) + S(2) * alpha));
+  S b = -beta / (S(1) + beta + std::sqrt(S(1) + S(2) * beta));
+  S b0 = (S(1) - neg_a1) / (S(1) + b);
+  return {b0, b * b0, neg_a1};
+}
+
+/*
+Cascade form of `SlopeFilter`. `[0]` to `[nCascade - 1]` are shelves in the order of processing.
+`b0[nCascade]` is output gain, and `b1[nCascade]` and `na1[nCascade]` are 0.
+*/
+template<typename Sample, size_t nCascade> struct SlopeFilterDesign {
+  alignas(32) std::array<Sample, nCascade + 1> b0{};
+  alignas(32) std::array<Sample, nCascade + 1> b1{};
+  alignas(32) std::array<Sample, nCascade + 1> na1{}; // -a1.
+};
+
+// TODO: pow(10, dB / 20) can be replaced to exp.
+template<typename Sample, size_t nCascade>
+inline SlopeFilterDesign<Sample, nCascade> designSlopeFilter(Sample sampleRate, Sample startHz,
+                                                             Sample slopeDecibel,
+                                                             Sample outputGain, bool isHighshelf) {
+  const Sample sign = isHighshelf ? Sample(1) : Sample(-1);
+  const Sample gainAmp = std::pow(Sample(10), sign * slopeDecibel / Sample(20));
+  const Sample ratio = isHighshelf ? Sample(2) : Sample(0.5);
+
+  SlopeFilterDesign<Sample, nCascade> design;
+  Sample cutoff = startHz / sampleRate;
+  Sample nyquistGain = Sample(1);
+  for (size_t i = 0; i < nCascade; ++i) {
+    const auto co = matchedHighShelf1(cutoff, gainAmp);
+    design.b0[i] = co[0];
+    design.b1[i] = co[1];
+    design.na1[i] = co[2];
+    nyquistGain *= (co[0] - co[1]) / (Sample(1) + co[2]);
+    cutoff *= ratio;
+  }
+
+  // Low shelf is made from high shelves, so the gain is normalized at Nyquist frequency.
+  design.b0[nCascade] = isHighshelf
+    ? outputGain
+    : outputGain / std::max(nyquistGain, std::numeric_limits<Sample>::epsilon());
+  return design;
+}
+
+/*
+Coefficients of `SlopeFilter`, shared by all channels.
+
+Coefficients are smoothed per sample only while they are moving. `isSmoothing()` becomes `false`
+once all coefficients are close enough to their targets, and `process()` doesn't have to be
+called after that. Convergence is checked by `updateConvergence()` at the end of each block.
+*/
+template<typename Sample, size_t nCascade> class SlopeFilterCoefficient {
 private:
   static constexpr Sample kp_ = Sample(0.0013081403895582485);
-  std::array<Sample, 3> coTarget_{}; // Target coefficients {b0, b1, -a1}.
-  std::array<Sample, 3> coV_{};      // Current coefficients.
+  static constexpr Sample tolerance = Sample(1e-10);
 
-  Sample x1_ = 0;
-  Sample y1_ = 0;
+  SlopeFilterDesign<Sample, nCascade> target_;
+  bool isSmoothing_ = false;
 
 public:
-  Sample nyquistGain() const { return (coTarget_[0] - coTarget_[1]) / (Sample(1) + coTarget_[2]); }
-
-  void push(Sample cutoffNormalized, Sample gainAmp) {
-    using S = Sample;
-
-    constexpr S minCut = S(10.0 / 48000.0);
-    constexpr S maxCut = S(20000.0 / 44100.0);
-    if (cutoffNormalized < minCut) {
-      cutoffNormalized = minCut;
-      gainAmp = S(1);
-    } else if (cutoffNormalized > maxCut) {
-      cutoffNormalized = maxCut;
-      gainAmp = S(1);
-    }
+  // Current values. See `SlopeFilterDesign` for the layout.
+  alignas(32) std::array<Sample, nCascade + 1> b0{};
+  alignas(32) std::array<Sample, nCascade + 1> b1{};
+  alignas(32) std::array<Sample, nCascade + 1> na1{};
 
-    constexpr S pi = std::numbers::pi_v<S>;
-    constexpr S phim = S(1.9510565162951536); // 1 - cos(pi * 0.9).
-    constexpr S pp = S(2) / (pi * pi);
-    constexpr S xi = pp / (phim * phim) - S(1) / phim;
+  bool isSmoothing() const { return isSmoothing_; }
 
-    const S fc2 = cutoffNormalized * cutoffNormalized / S(4);
-    S alpha = xi + pp / (gainAmp * fc2);
-    S beta = xi + pp * gainAmp / fc2;
-
-    S neg_a1 = alpha / (S(1) + alpha + std::sqrt(S(1) + S(2) * alpha));
-    S b = -beta / (S(1) + beta + std::sqrt(S(1) + S(2) * beta));
-    coTarget_[0] = (S(1) - neg_a1) / (S(1) + b); // b0
-    coTarget_[1] = b * coTarget_[0];             // b1
-    coTarget_[2] = neg_a1;                       // -a1
+  void push(Sample sampleRate, Sample startHz, Sample slopeDecibel, Sample outputGain,
+            bool isHighshelf) {
+    target_ = designSlopeFilter<Sample, nCascade>(sampleRate, startHz, slopeDecibel, outputGain,
+                                                  isHighshelf);
+    isSmoothing_ = target_.b0 != b0 || target_.b1 != b1 || target_.na1 != na1;
   }
 
-  void reset(Sample cutoffNormalized, Sample gainAmp) {
-    push(cutoffNormalized, gainAmp);
-    coV_ = coTarget_;
+  void reset(Sample sampleRate, Sample startHz, Sample slopeDecibel, Sample outputGain,
+             bool isHighshelf) {
+    push(sampleRate, startHz, slopeDecibel, outputGain, isHighshelf);
+    b0 = target_.b0;
+    b1 = target_.b1;
+    na1 = target_.na1;
+    isSmoothing_ = false;
+  }
 
-    x1_ = 0;
-    y1_ = 0;
+  void process() {
+    for (size_t i = 0; i <= nCascade; ++i) {
+      b0[i] += kp_ * (target_.b0[i] - b0[i]);
+      b1[i] += kp_ * (target_.b1[i] - b1[i]);
+      na1[i] += kp_ * (target_.na1[i] - na1[i]);
+    }
   }
 
-  Sample process(Sample x0) {
-    for (size_t i = 0; i < coV_.size(); ++i) { coV_[i] += kp_ * (coTarget_[i] - coV_[i]); }
+  void updateConvergence() {
+    if (!isSmoothing_) { return; }
 
-    auto y0 = coV_[0] * x0 + coV_[1] * x1_ + coV_[2] * y1_;
-    x1_ = x0;
-    y1_ = y0;
-    return y0;
+    // Tolerance is scaled for large coefficients. `b0[nCascade]` has output gain and Nyquist
+    // normalization of low shelf, and it reaches 1e5 or more. The smoother stalls at around
+    // `ulp / kp_` there, which is larger than absolute `tolerance`.
+    auto isFar = [](Sample target, Sample value) {
+      return std::abs(target - value) > tolerance * std::max(Sample(1), std::abs(target));
+    };
+    for (size_t i = 0; i <= nCascade; ++i) {
+      const bool isMoving = isFar(target_.b0[i], b0[i]) || isFar(target_.b1[i], b1[i])
+        || isFar(target_.na1[i], na1[i]);
+      if (isMoving) { return; }
+    }
+
+    b0 = target_.b0;
+    b1 = target_.b1;
+    na1 = target_.na1;
+    isSmoothing_ = false;
   }
 };
 
-template<typename Sample, size_t nCascade> class SlopeFilter {
-private:
-  std::array<MatchedHighShelf1<Sample>, nCascade> filters_;
+/*
+Coefficients of `SlopeFilterParallel`, which is the partial fraction expansion of the cascade.
+
+  H(z) = g * prod_i (b0_i + b1_i z^-1) / (1 - p_i z^-1)
+       = d + sum_i r_i / (1 - p_i z^-1).
+
+Poles `p_i` are distinct because the cutoffs are an octave apart. Shelves with 0 dB gain have the
+zero on the pole, so they are folded into `g` instead of being expanded. This includes shelves
+clamped to the frequency limits, which may share the same pole. The direct term `d` is
+stored as a section with pole 0. The number of sections is padded to `nLane` with 0, so that the
+loop in `SlopeFilterParallel::process` can be fully vectorized.
 
+Smoothing and convergence work in the same way as `SlopeFilterCoefficient`, but poles and
+residues are smoothed instead of the cascade coefficients. Tolerance of residues is relative to the
+largest residue.
+*/
+template<typename Sample, size_t nCascade> class SlopeFilterParallelCoefficient {
+public:
+  static constexpr size_t nLane = (nCascade + 1 + 3) / 4 * 4;
+
+private:
   static constexpr Sample kp_ = Sample(0.0013081403895582485);
-  Sample gainTarget_ = Sample(1);
-  Sample gainV_ = Sample(1);
+  static constexpr Sample tolerance = Sample(1e-10);
+  static constexpr Sample cancellationTolerance = Sample(1e-12);
 
-  inline Sample lowshelfGain() {
-    Sample gain = Sample(1);
-    for (const auto& flt : filters_) { gain *= flt.nyquistGain(); }
-    return Sample(1) / std::max(gain, std::numeric_limits<Sample>::epsilon());
-  }
+  alignas(32) std::array<Sample, nLane> poleTarget_{};
+  alignas(32) std::array<Sample, nLane> residueTarget_{};
+  Sample residueScale_ = Sample(1);
+  bool isSmoothing_ = false;
 
 public:
-// TODO: pow(10, dB / 20) can be replaced to exp.
-#define SET_SLOPE_FILTER_PARAMETERS(METHOD)                                                        \
-  if (isHighshelf) {                                                                               \
-    Sample gainAmp = std::pow(Sample(10), slopeDecibel / Sample(20));                              \
-    Sample cutoff = startHz / sampleRate;                                                          \
-    for (auto& flt : filters_) {                                                                   \
-      flt.push(cutoff, gainAmp);                                                                   \
-      cutoff *= Sample(2);                                                                         \
-    }                                                                                              \
-    gainTarget_ = outputGain;                                                                      \
-  } else { /* Low shelf */                                                                         \
-    Sample gainAmp = std::pow(Sample(10), -slopeDecibel / Sample(20));                             \
-    Sample cutoff = startHz / sampleRate;                                                          \
-    for (auto& flt : filters_) {                                                                   \
-      flt.push(cutoff, gainAmp);                                                                   \
-      cutoff *= Sample(0.5);                                                                       \
-    }                                                                                              \
-    gainTarget_ = outputGain * lowshelfGain();                                                     \
-  }
+  alignas(32) std::array<Sample, nLane> pole{};
+  alignas(32) std::array<Sample, nLane> residue{};
+
+  bool isSmoothing() const { return isSmoothing_; }
 
   void push(Sample sampleRate, Sample startHz, Sample slopeDecibel, Sample outputGain,
             bool isHighshelf) {
-    SET_SLOPE_FILTER_PARAMETERS(push);
+    const auto cascade = designSlopeFilter<Sample, nCascade>(sampleRate, startHz, slopeDecibel,
+                                                             outputGain, isHighshelf);
+
+    // Exact comparison doesn't work, because `-ffast-math` may round the zero and pole of a 0 dB
+    // shelf differently.
+    std::array<bool, nCascade> isExpanded{};
+    Sample gain = cascade.b0[nCascade];
+    for (size_t i = 0; i < nCascade; ++i) {
+      const Sample zeroPoleDistance = cascade.b1[i] + cascade.b0[i] * cascade.na1[i];
+      isExpanded[i] = std::abs(zeroPoleDistance) > cancellationTolerance * std::abs(cascade.b0[i]);
+      if (!isExpanded[i]) { gain *= cascade.b0[i]; }
+    }
+
+    // At `z^-1 -> infinity`, each shelf goes to `-b1 / p`.
+    Sample direct = gain;
+    for (size_t i = 0; i < nCascade; ++i) {
+      poleTarget_[i] = cascade.na1[i];
+      residueTarget_[i] = 0;
+      if (isExpanded[i]) { direct *= -cascade.b1[i] / cascade.na1[i]; }
+    }
+
+    // Residue at `z^-1 = 1 / p_i`.
+    residueScale_ = std::abs(direct);
+    for (size_t i = 0; i < nCascade; ++i) {
+      if (!isExpanded[i]) { continue; }
+      const Sample w = Sample(1) / cascade.na1[i];
+      Sample r = gain * (cascade.b0[i] + cascade.b1[i] * w);
+      for (size_t j = 0; j < nCascade; ++j) {
+        if (j == i || !isExpanded[j]) { continue; }
+        r *= (cascade.b0[j] + cascade.b1[j] * w) / (Sample(1) - cascade.na1[j] * w);
+      }
+      residueTarget_[i] = r;
+      residueScale_ = std::max(residueScale_, std::abs(r));
+    }
+    poleTarget_[nCascade] = 0;
+    residueTarget_[nCascade] = direct;
+
+    isSmoothing_ = poleTarget_ != pole || residueTarget_ != residue;
   }
 
   void reset(Sample sampleRate, Sample startHz, Sample slopeDecibel, Sample outputGain,
              bool isHighshelf) {
-    SET_SLOPE_FILTER_PARAMETERS(reset);
-    gainV_ = gainTarget_;
+    push(sampleRate, startHz, slopeDecibel, outputGain, isHighshelf);
+    pole = poleTarget_;
+    residue = residueTarget_;
+    isSmoothing_ = false;
+  }
+
+  void process() {
+    for (size_t i = 0; i < nLane; ++i) {
+      pole[i] += kp_ * (poleTarget_[i] - pole[i]);
+      residue[i] += kp_ * (residueTarget_[i] - residue[i]);
+    }
+  }
+
+  void updateConvergence() {
+    if (!isSmoothing_) { return; }
+
+    Sample poleDiff = 0;
+    Sample residueDiff = 0;
+    for (size_t i = 0; i < nLane; ++i) {
+      poleDiff = std::max(poleDiff, std::abs(poleTarget_[i] - pole[i]));
+      residueDiff = std::max(residueDiff, std::abs(residueTarget_[i] - residue[i]));
+    }
+    if (poleDiff > tolerance || residueDiff > tolerance * residueScale_) { return; }
+
+    pole = poleTarget_;
+    residue = residueTarget_;
+    isSmoothing_ = false;
+  }
+};
+
+// Cascade of 1-pole shelves. Each octave from the start frequency has one shelf.
+template<typename Sample, size_t nCascade> class SlopeFilter {
+public:
+  using Coefficient = SlopeFilterCoefficient<Sample, nCascade>;
+
+private:
+  std::array<Sample, nCascade> x1_{};
+  std::array<Sample, nCascade> y1_{};
+
+public:
+  void reset() {
+    x1_.fill(0);
+    y1_.fill(0);
+  }
+
+  Sample process(Sample x0, const Coefficient& co) {
+    for (size_t i = 0; i < nCascade; ++i) {
+      auto y0 = co.b0[i] * x0 + co.b1[i] * x1_[i] + co.na1[i] * y1_[i];
+      x1_[i] = x0;
+      y1_[i] = y0;
+      x0 = y0;
+    }
+    return co.b0[nCascade] * x0;
   }
+};
 
-#undef SET_SLOPE_FILTER_PARAMETERS
+// Parallel form of `SlopeFilter`. Sections are independent, so they are processed as lanes.
+template<typename Sample, size_t nCascade> class SlopeFilterParallel {
+public:
+  using Coefficient = SlopeFilterParallelCoefficient<Sample, nCascade>;
 
-  Sample process(Sample x0) {
-    for (auto& flt : filters_) { x0 = flt.process(x0); }
+private:
+  alignas(32) std::array<Sample, Coefficient::nLane> s1_{};
 
-    gainV_ += kp_ * (gainTarget_ - gainV_);
-    return gainV_ * x0;
+public:
+  void reset() { s1_.fill(0); }
+
+  Sample process(Sample x0, const Coefficient& co) {
+    Sample y0 = 0;
+    for (size_t i = 0; i < Coefficient::nLane; ++i) {
+      s1_[i] = x0 + co.pole[i] * s1_[i];
+      y0 += co.residue[i] * s1_[i];
+    }
+    return y0;
   }
 };
 
@@ -19,8 +19,8 @@ struct Metrics {
   int labelX = labelW + 2 * margin;
   int labelY = labelH + 2 * margin;
   int sectionWidth = 2 * labelW + 2 * margin;
-  int totalWidth = 2 * sectionWidth + 3 * uiMargin;
-  int totalHeight = 10 * labelY;
+  int totalWidth = 3 * sectionWidth + 4 * uiMargin;
+  int totalHeight = 12 * labelY;
 
   Metrics() = default;
 
@@ -36,13 +36,35 @@ struct Metrics {
   }
 };
 
+const juce::String sCrossover{"Crossover"};
 const juce::String sStereoControl{"Stereo Control"};
 
-Editor::Editor(Processor& proc) : EditorBase(proc, informationText) {
+Editor::Editor(Processor& proc)
+    : EditorBase(proc, informationText),
+      crossoverOrderAttachment_(
+        *proc.param.tree.getParameter("crossoverOrder"),
+        [this](float) { processor_.setLatencySamples(int(processor_.dsp.getLatency())); }, nullptr),
+      crossoverAccuracyAttachment_(
+        *proc.param.tree.getParameter("crossoverAccuracy"),
+        [this](float) { processor_.setLatencySamples(int(processor_.dsp.getLatency())); },
+        nullptr) {
   auto& sc = proc.param.scale;
 
-  addTextKnob(sStereoControl, "crossoverHz", sc.crossoverHz, {}, 5);
+  addComboBox(sCrossover, "bandCount", sc.bandCount, {"2", "3", "4", "5", "6"}, "");
+  addTextKnob(sCrossover, "crossoverHz", sc.crossoverHz, {}, 5);
+  addTextKnob(sCrossover, "crossoverHz1", sc.crossoverHz, {}, 5);
+  addTextKnob(sCrossover, "crossoverHz2", sc.crossoverHz, {}, 5);
+  addTextKnob(sCrossover, "crossoverHz3", sc.crossoverHz, {}, 5);
+  addTextKnob(sCrossover, "crossoverHz4", sc.crossoverHz, {}, 5);
+  addComboBox(sCrossover, "crossoverOrder", sc.crossoverOrder, {"24 dB/oct", "48 dB/oct"}, "");
+  addComboBox(sCrossover, "crossoverAccuracy", sc.crossoverAccuracy,
+              {"Low Latency", "Standard", "High Accuracy"}, "");
+
   addTextKnob(sStereoControl, "upperStereoSpread", sc.unipolar, {}, 5);
+  addTextKnob(sStereoControl, "midStereoSpread4", sc.unipolar, {}, 5);
+  addTextKnob(sStereoControl, "midStereoSpread3", sc.unipolar, {}, 5);
+  addTextKnob(sStereoControl, "midStereoSpread2", sc.unipolar, {}, 5);
+  addTextKnob(sStereoControl, "midStereoSpread1", sc.unipolar, {}, 5);
   addTextKnob(sStereoControl, "lowerStereoSpread", sc.unipolar, {}, 5);
 
   // `setSize` must be called at last.
@@ -64,18 +86,26 @@ void Editor::resized() {
   const int top0 = mt.uiMargin;
   const int left0 = mt.uiMargin;
   const int left1 = left0 + mt.sectionWidth + mt.uiMargin;
+  const int left2 = left1 + mt.sectionWidth + mt.uiMargin;
 
   int currentTop = top0;
-  if (auto sc = sections_.find(sStereoControl); sc != sections_.end()) {
+  if (auto sc = sections_.find(sCrossover); sc != sections_.end()) {
     currentTop = layoutVerticalSection(groupLabels_, left0, currentTop, mt.sectionWidth, mt.labelH,
                                        mt.labelY, sc->first, sc->second);
   }
 
-  layoutActionSectionAndPluginInfo(left1, top0, mt.sectionWidth, mt.labelW, mt.labelX, mt.labelH,
+  currentTop = top0;
+  if (auto sc = sections_.find(sStereoControl); sc != sections_.end()) {
+    currentTop = layoutVerticalSection(groupLabels_, left1, currentTop, mt.sectionWidth, mt.labelH,
+                                       mt.labelY, sc->first, sc->second);
+  }
+
+  layoutActionSectionAndPluginInfo(left2, top0, mt.sectionWidth, mt.labelW, mt.labelX, mt.labelH,
                                    mt.labelY);
 
-  statusBar_.setBounds(
-    Rect{left0, bottom - mt.labelH - mt.uiMargin, mt.totalWidth - 2 * mt.uiMargin, mt.labelH});
+  layoutStatusBar(
+    Rect{left0, bottom - mt.labelH - mt.uiMargin, mt.totalWidth - 2 * mt.uiMargin, mt.labelH},
+    mt.margin, mt.labelW);
 }
 
 } // namespace Uhhyou
@@ -17,6 +17,10 @@ public:
   ~Editor() override {}
 
   void resized() override;
+
+private:
+  juce::ParameterAttachment crossoverOrderAttachment_;
+  juce::ParameterAttachment crossoverAccuracyAttachment_;
 };
 
 } // namespace Uhhyou
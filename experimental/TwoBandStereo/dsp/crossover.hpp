@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <complex>
@@ -19,7 +20,7 @@ private:
   std::array<Sample, length> buf_{};
 
 public:
-  void reset(Sample value = 0) {
+  void reset(const Sample& value = {}) {
     ptr_ = 0;
     buf_.fill(value);
   }
@@ -32,99 +33,162 @@ public:
   }
 };
 
-template<typename Sample, size_t fullStage, size_t recStage> struct ComplexIIRDelay;
+// Poles are shared by all `ComplexIIR` with the same cutoff, including other channels.
+template<typename Sample, size_t stage> struct ComplexIIRCoefficient {
+  Sample a_per_b = 0;
+  std::array<std::complex<Sample>, stage> poles{};
 
-template<typename Sample, size_t fullStage> struct ComplexIIRDelay<Sample, fullStage, 0> {
-  void reset() {}
-
-  using C = std::complex<Sample>;
-  inline C process1PoleForward(C x0, const std::array<C, fullStage>&) { return x0; }
-  inline C process1PoleReversed(C x0, const std::array<C, fullStage>&) { return x0; }
+  void prepare(std::complex<Sample> pole) {
+    a_per_b = pole.real() / pole.imag();
+    for (auto& value : poles) {
+      value = pole;
+      pole *= pole;
+    }
+  }
 };
 
-template<typename Sample, size_t fullStage, size_t recStage> struct ComplexIIRDelay {
-  static constexpr size_t index = fullStage - recStage;
-  FixedIntDelay<std::complex<Sample>, size_t(1) << index> delay;
-  ComplexIIRDelay<Sample, fullStage, recStage - 1> recursion;
+/*
+Truncated complex 1-pole IIR. Stage `k` adds a delay of `2^k` samples. Delays of all stages are in
+one buffer, and real and imaginary parts are stored separately. Each of `nLane` is an independent
+signal with the same coefficient. Loops over lanes are meant to be vectorized by compiler.
+
+`Sample = float` fits twice as many lanes in a vector register. Output of 6-band `float` crossover
+differs from `double` by about -90 dB, so `double` is used in the plugin.
+*/
+template<typename Sample, size_t stage = 8, size_t nLane = 1> class ComplexIIR {
+public:
+  using Coefficient = ComplexIIRCoefficient<Sample, stage>;
+  using Lane = std::array<Sample, nLane>;
+
+private:
+  static_assert(stage >= 1);
+
+  // Delay of stage `k` is at `[2^k - 2, 2^(k+1) - 2)`. Stage 0 is `x1_`.
+  static constexpr size_t bufferSize = std::max(size_t(1), (size_t(1) << stage) - 2);
+  static constexpr size_t counterMask = (size_t(1) << (stage - 1)) - 1;
+
+  size_t counter_ = 0;
+  Lane x1_{};
+  std::array<Lane, bufferSize> re_{};
+  std::array<Lane, bufferSize> im_{};
+
+  template<bool isReversed> inline Lane process2Pole(const Lane& x0, const Coefficient& co) {
+    Lane sr;
+    Lane si;
+    {
+      const Sample pr = co.poles[0].real();
+      const Sample pi = co.poles[0].imag();
+      for (size_t n = 0; n < nLane; ++n) {
+        sr[n] = isReversed ? pr * x0[n] + x1_[n] : x0[n] + pr * x1_[n];
+        si[n] = pi * (isReversed ? x0[n] : x1_[n]);
+      }
+      x1_ = x0;
+    }
+
+    for (size_t k = 1; k < stage; ++k) {
+      const size_t index = (size_t(1) << k) - 2 + (counter_ & ((size_t(1) << k) - 1));
+      auto& dr = re_[index];
+      auto& di = im_[index];
+      const Sample pr = co.poles[k].real();
+      const Sample pi = co.poles[k].imag();
+      for (size_t n = 0; n < nLane; ++n) {
+        const Sample yr = dr[n];
+        const Sample yi = di[n];
+        dr[n] = sr[n];
+        di[n] = si[n];
+        if constexpr (isReversed) {
+          const Sample xr = sr[n];
+          sr[n] = pr * xr - pi * si[n] + yr;
+          si[n] = pr * si[n] + pi * xr + yi;
+        } else {
+          sr[n] += pr * yr - pi * yi;
+          si[n] += pr * yi + pi * yr;
+        }
+      }
+    }
+    counter_ = (counter_ + 1) & counterMask;
+
+    Lane y0;
+    for (size_t n = 0; n < nLane; ++n) { y0[n] = sr[n] + co.a_per_b * si[n]; }
+    return y0;
+  }
 
+public:
   void reset() {
-    delay.reset();
-    recursion.reset();
+    counter_ = 0;
+    x1_.fill(0);
+    for (auto& x : re_) { x.fill(0); }
+    for (auto& x : im_) { x.fill(0); }
   }
 
-  inline std::complex<Sample>
-  process1PoleForward(std::complex<Sample> x0,
-                      const std::array<std::complex<Sample>, fullStage>& poles) {
-    return recursion.process1PoleForward(x0 + poles[index] * delay.process(x0), poles);
+  Lane process2PoleForward(const Lane& x0, const Coefficient& co) {
+    return process2Pole<false>(x0, co);
   }
 
-  inline std::complex<Sample>
-  process1PoleReversed(std::complex<Sample> x0,
-                       const std::array<std::complex<Sample>, fullStage>& poles) {
-    return recursion.process1PoleReversed(poles[index] * x0 + delay.process(x0), poles);
+  Lane process2PoleReversed(const Lane& x0, const Coefficient& co) {
+    return process2Pole<true>(x0, co);
   }
 };
 
-template<typename Sample, size_t stage = 8> class ComplexIIR {
-private:
-  static constexpr size_t nPoles = stage - 1;
+/*
+Coefficients of `LinkwitzRileyFIR`. `prepare` only recomputes when the crossover frequency moves
+more than `tolerance` relative to the last computed one, so it can be called on every sample. The
+error of the crossover frequency is bounded by the tolerance, which is about 0.02 cents.
+*/
+template<typename Sample, size_t order, size_t stage = 8> class LinkwitzRileyFIRCoefficient {
+public:
+  static constexpr size_t nSection = order / 4;
+  static constexpr Sample tolerance = Sample(1e-5);
 
-  Sample a_per_b_ = 0;
-  std::array<std::complex<Sample>, stage> poles_;
+  std::array<ComplexIIRCoefficient<Sample, stage>, nSection> section;
+  Sample gain = Sample(1);
 
-  std::complex<Sample> x1_ = 0;
-  ComplexIIRDelay<Sample, stage, stage - 1> delay_;
+private:
+  Sample crossover_ = Sample(-1);
 
 public:
-  void reset() {
-    x1_ = 0;
-    delay_.reset();
-  }
+  void reset() { crossover_ = Sample(-1); }
 
-  void prepare(std::complex<Sample> pole) {
-    a_per_b_ = pole.real() / pole.imag();
-    for (auto& value : poles_) {
-      value = pole;
-      pole *= pole;
-    }
-  }
+  // Returns `true` when coefficients are updated.
+  bool prepare(Sample normalizedCrossover) {
+    if (std::abs(normalizedCrossover - crossover_) <= tolerance * crossover_) { return false; }
+    crossover_ = normalizedCrossover;
 
-  std::complex<Sample> process1PoleForward(Sample x0) {
-    std::complex<Sample> sig = x0 + poles_[0] * x1_;
-    x1_ = x0;
-    return delay_.process1PoleForward(sig, poles_);
-  }
+    constexpr Sample pi = std::numbers::pi_v<Sample>;
+    constexpr size_t N = 2 * nSection; // Butterworth order.
 
-  std::complex<Sample> process1PoleReversed(Sample x0) {
-    std::complex<Sample> sig = poles_[0] * x0 + x1_;
-    x1_ = x0;
-    return delay_.process1PoleReversed(sig, poles_);
-  }
+    gain = Sample(1);
 
-  Sample process2PoleForward(Sample x0) {
-    std::complex<Sample> sig = process1PoleForward(x0);
-    return sig.real() + a_per_b_ * sig.imag();
-  }
+    auto cutoffRadian = Sample(2) * pi * normalizedCrossover;
+    for (size_t idx = 0; idx < nSection; ++idx) {
+      auto m = Sample(2 * idx) - Sample(N) + Sample(1);
+      auto analogPole = cutoffRadian * std::polar(Sample(-1), pi * m / Sample(2 * N));
+      auto pole = (Sample(2) + analogPole) / (Sample(2) - analogPole);
+      section[idx].prepare(pole);
+      gain *= (Sample(1) + Sample(-2) * pole.real() + std::norm(pole)) / Sample(4);
+    }
 
-  Sample process2PoleReversed(Sample x0) {
-    std::complex<Sample> sig = process1PoleReversed(x0);
-    return sig.real() + a_per_b_ * sig.imag();
+    gain = std::pow(gain, Sample(1) / Sample(nSection));
+    return true;
   }
 };
 
-template<typename Sample, size_t order, size_t stage = 8> class LinkwitzRileyFIR {
+template<typename Sample, size_t order, size_t stage = 8, size_t nLane = 1>
+class LinkwitzRileyFIR {
+public:
+  using Coefficient = LinkwitzRileyFIRCoefficient<Sample, order, stage>;
+  using Lane = std::array<Sample, nLane>;
+
 private:
   static constexpr size_t nSection = order / 4;
 
-  std::array<ComplexIIR<Sample, stage>, nSection> reverse_;
-  std::array<ComplexIIR<Sample, stage>, nSection> forward_;
-
-  std::array<Sample, nSection> u1_{};
-  std::array<Sample, nSection> u2_{};
-  std::array<Sample, nSection> v1_{};
-  std::array<Sample, nSection> v2_{};
+  std::array<ComplexIIR<Sample, stage, nLane>, nSection> reverse_;
+  std::array<ComplexIIR<Sample, stage, nLane>, nSection> forward_;
 
-  Sample gain_ = Sample(1);
+  std::array<Lane, nSection> u1_{};
+  std::array<Lane, nSection> u2_{};
+  std::array<Lane, nSection> v1_{};
+  std::array<Lane, nSection> v2_{};
 
 public:
   static constexpr size_t latency = nSection * (size_t(1) << stage) + 1;
@@ -135,74 +199,94 @@ public:
     for (auto& x : reverse_) { x.reset(); }
     for (auto& x : forward_) { x.reset(); }
 
-    u1_.fill({});
-    u2_.fill({});
-    v1_.fill({});
-    v2_.fill({});
-  }
-
-  void prepare(Sample normalizedCrossover) {
-    constexpr Sample pi = std::numbers::pi_v<Sample>;
-    constexpr size_t N = 2 * nSection; // Butterworth order.
-
-    gain_ = Sample(1);
-
-    auto cutoffRadian = Sample(2) * pi * normalizedCrossover;
-    for (size_t idx = 0; idx < nSection; ++idx) {
-      auto m = Sample(2 * idx) - Sample(N) + Sample(1);
-      auto analogPole = cutoffRadian * std::polar(Sample(-1), pi * m / Sample(2 * N));
-      auto pole = (Sample(2) + analogPole) / (Sample(2) - analogPole);
-      reverse_[idx].prepare(pole);
-      forward_[idx].prepare(pole);
-      gain_ *= (Sample(1) + Sample(-2) * pole.real() + std::norm(pole)) / Sample(4);
+    for (size_t i = 0; i < nSection; ++i) {
+      u1_[i].fill(0);
+      u2_[i].fill(0);
+      v1_[i].fill(0);
+      v2_[i].fill(0);
     }
-
-    gain_ = std::pow(gain_, Sample(1) / Sample(nSection));
   }
 
-  Sample process(Sample x0) {
+  Lane process(Lane x0, const Coefficient& co) {
     constexpr Sample a1 = Sample(2); // -2 for highpass.
 
+    Lane sig;
     for (size_t i = 0; i < nSection; ++i) {
-      Sample u0 = reverse_[i].process2PoleReversed(x0 * gain_);
-      x0 = u0 + a1 * u1_[i] + u2_[i];
+      for (size_t n = 0; n < nLane; ++n) { sig[n] = x0[n] * co.gain; }
+      const Lane u0 = reverse_[i].process2PoleReversed(sig, co.section[i]);
+      for (size_t n = 0; n < nLane; ++n) {
+        sig[n] = (u0[n] + a1 * u1_[i][n] + u2_[i][n]) * co.gain;
+      }
       u2_[i] = u1_[i];
       u1_[i] = u0;
 
-      Sample v0 = forward_[i].process2PoleForward(x0 * gain_);
-      x0 = v0 + a1 * v1_[i] + v2_[i];
+      const Lane v0 = forward_[i].process2PoleForward(sig, co.section[i]);
+      for (size_t n = 0; n < nLane; ++n) { x0[n] = v0[n] + a1 * v1_[i][n] + v2_[i][n]; }
       v2_[i] = v1_[i];
       v1_[i] = v0;
     }
     return x0;
   }
+
+  Sample process(Sample x0, const Coefficient& co)
+    requires(nLane == 1)
+  {
+    return process(Lane{x0}, co)[0];
+  }
 };
 
-template<typename Sample, size_t order, size_t stage = 8> class LinkwitzRileyFIR2Band4n {
+/*
+Linear phase crossover with up to `maxBand` bands. All lowpasses have the same latency, so band `k`
+is the difference of adjacent lowpasses, and the top band is the delayed input minus the highest
+lowpass. The delay is shared by all bands, and the cost grows linearly with the number of bands.
+Sum of all bands is the input delayed by `latency`.
+
+Crossover frequencies must be in ascending order. Equal frequencies make an empty band.
+*/
+template<typename Sample, size_t order, size_t stage, size_t maxBand, size_t nLane = 1>
+class LinkwitzRileyFIRNBand {
 public:
+  using Coefficient = LinkwitzRileyFIRCoefficient<Sample, order, stage>;
+  using Lane = std::array<Sample, nLane>;
   static constexpr size_t latency = LinkwitzRileyFIR<Sample, order, stage>::latency;
 
 private:
-  LinkwitzRileyFIR<Sample, order, stage> lowpass_;
-  FixedIntDelay<Sample, latency> highpassDelay_;
+  static_assert(maxBand >= 2);
+
+  size_t nBand_ = maxBand;
+  std::array<LinkwitzRileyFIR<Sample, order, stage, nLane>, maxBand - 1> lowpass_;
+  FixedIntDelay<Lane, latency> delay_;
 
 public:
-  std::array<Sample, 2> output{}; // 0: low, 1: high.
+  std::array<Lane, maxBand> output{}; // `output[band][lane]`. Bands are in ascending order.
 
-  LinkwitzRileyFIR2Band4n() { static_assert(order % 4 == 0 && order >= 4); }
+  LinkwitzRileyFIRNBand() { static_assert(order % 4 == 0 && order >= 4); }
 
   size_t getLatency() { return latency; }
 
   void reset() {
-    lowpass_.reset();
-    highpassDelay_.reset();
+    for (auto& x : lowpass_) { x.reset(); }
+    delay_.reset();
+    for (auto& x : output) { x.fill(0); }
   }
 
-  void prepare(Sample normalizedCrossover) { lowpass_.prepare(normalizedCrossover); }
+  // Lowpasses enabled by this call start from cleared state.
+  void setBandCount(size_t nBand) {
+    nBand = std::clamp(nBand, size_t(2), maxBand);
+    for (size_t i = nBand_ - 1; i < nBand - 1; ++i) { lowpass_[i].reset(); }
+    for (size_t i = nBand; i < maxBand; ++i) { output[i].fill(0); }
+    nBand_ = nBand;
+  }
 
-  void process(Sample x0) {
-    output[0] = lowpass_.process(x0);
-    output[1] = highpassDelay_.process(x0) - output[0];
+  void process(const Lane& x0, const std::array<Coefficient, maxBand - 1>& co) {
+    Lane lower{};
+    for (size_t i = 0; i < nBand_ - 1; ++i) {
+      const Lane lowpassed = lowpass_[i].process(x0, co[i]);
+      for (size_t n = 0; n < nLane; ++n) { output[i][n] = lowpassed[n] - lower[n]; }
+      lower = lowpassed;
+    }
+    const Lane delayed = delay_.process(x0);
+    for (size_t n = 0; n < nLane; ++n) { output[nBand_ - 1][n] = delayed[n] - lower[n]; }
   }
 };
 
@@ -20,19 +20,82 @@ void DSPCore::setup(double sampleRate) {
   startup();
 }
 
-size_t DSPCore::getLatency() { return crossoverFilter_[0].getLatency(); }
+// Latency is taken from parameters instead of `crossover_`, because this may be called from GUI
+// thread while audio thread is switching the crossover.
+size_t DSPCore::getLatency() {
+  static constexpr auto table = []<size_t... i>(std::index_sequence<i...>) {
+    return std::array<size_t, nCrossover>{StereoCrossoverAt<i>::Filter::latency...};
+  }(std::make_index_sequence<nCrossover>{});
+
+  return table[crossoverIndex()];
+}
+
+size_t DSPCore::crossoverIndex() {
+  auto& pv = param.value;
+  const auto order = std::min(size_t(pv.crossoverOrder->load()), crossoverOrders.size() - 1);
+  const auto stage = std::min(size_t(pv.crossoverAccuracy->load()), crossoverStages.size() - 1);
+  return order * crossoverStages.size() + stage;
+}
+
+// Switching constructs the new crossover in place of the old one, so its state starts from zero.
+void DSPCore::selectCrossover(size_t index) {
+  if (index == crossover_.index()) { return; }
+
+  using Emplace = void (*)(CrossoverVariant&);
+  static constexpr auto table = []<size_t... i>(std::index_sequence<i...>) {
+    return std::array<Emplace, nCrossover>{
+      [](CrossoverVariant& variant) { variant.template emplace<i>(); }...};
+  }(std::make_index_sequence<nCrossover>{});
+
+  table[index](crossover_);
+}
+
+// Band count is passed to filters on every call, because a newly selected crossover starts with
+// all bands enabled.
+void DSPCore::setBandCount(size_t nBand) {
+  nBand_ = std::clamp(nBand, size_t(2), maxBand);
+  std::visit([&](auto& crossover) { crossover.filter.setBandCount(nBand_); }, crossover_);
+}
 
 #define ASSIGN_PARAMETER(METHOD)                                                                   \
   auto& pv = param.value;                                                                          \
                                                                                                    \
-  crossoverFreq_.METHOD(pv.crossoverHz->load() / sampleRate_);                                     \
-  lowerStereoSpread_.METHOD(pv.lowerStereoSpread->load());                                         \
-  upperStereoSpread_.METHOD(pv.upperStereoSpread->load());
+  selectCrossover(crossoverIndex());                                                               \
+  setBandCount(size_t(pv.bandCount->load()) + 2);                                                  \
+                                                                                                   \
+  std::array<double, maxBand - 1> crossoverHz{                                                     \
+    pv.crossoverHz->load(),                                                                        \
+    pv.crossoverHz1->load(),                                                                       \
+    pv.crossoverHz2->load(),                                                                       \
+    pv.crossoverHz3->load(),                                                                       \
+    pv.crossoverHz4->load(),                                                                       \
+  };                                                                                               \
+  for (size_t i = 0; i < crossoverHz.size(); ++i) {                                                \
+    if (i > 0) { crossoverHz[i] = std::max(crossoverHz[i], crossoverHz[i - 1]); }                  \
+    crossoverFreq_.METHOD##At(i, crossoverHz[i] / sampleRate_);                                    \
+  }                                                                                                \
+                                                                                                   \
+  std::array<double, maxBand - 2> midStereoSpread{                                                 \
+    pv.midStereoSpread1->load(),                                                                   \
+    pv.midStereoSpread2->load(),                                                                   \
+    pv.midStereoSpread3->load(),                                                                   \
+    pv.midStereoSpread4->load(),                                                                   \
+  };                                                                                               \
+  stereoSpread_.METHOD##At(0, pv.lowerStereoSpread->load());                                       \
+  for (size_t i = 1; i < nBand_ - 1; ++i) {                                                        \
+    stereoSpread_.METHOD##At(i, midStereoSpread[i - 1]);                                           \
+  }                                                                                                \
+  stereoSpread_.METHOD##At(nBand_ - 1, pv.upperStereoSpread->load());
 
 void DSPCore::reset() {
   ASSIGN_PARAMETER(reset);
 
-  for (auto& x : crossoverFilter_) { x.reset(); }
+  std::visit(
+    [](auto& crossover) {
+      for (auto& x : crossover.coefficient) { x.reset(); }
+      crossover.filter.reset();
+    },
+    crossover_);
 
   startup();
 }
@@ -51,23 +114,37 @@ inline std::array<Sample, 2> mixStereo(Sample inL, Sample inR, Sample spread) {
   return {outL, outR};
 }
 
-void DSPCore::process(const size_t length, const float* in0, const float* in1, float* out0,
-                      float* out1) {
+template<typename Crossover>
+void DSPCore::processBlock(Crossover& crossover, const size_t length, const float* in0,
+                           const float* in1, float* out0, float* out1) {
+  auto& co = crossover.coefficient;
+  auto& filter = crossover.filter;
+
   for (size_t i = 0; i < length; ++i) {
     crossoverFreq_.process();
-    for (auto& x : crossoverFilter_) { x.prepare(crossoverFreq_.value()); }
+    stereoSpread_.process();
+
+    for (size_t k = 0; k < nBand_ - 1; ++k) { co[k].prepare(crossoverFreq_[k]); }
 
-    crossoverFilter_[0].process(double(in0[i]));
-    crossoverFilter_[1].process(double(in1[i]));
+    filter.process({double(in0[i]), double(in1[i])}, co);
 
-    auto lower = mixStereo(crossoverFilter_[0].output[0], crossoverFilter_[1].output[0],
-                           lowerStereoSpread_.process());
-    auto upper = mixStereo(crossoverFilter_[0].output[1], crossoverFilter_[1].output[1],
-                           upperStereoSpread_.process());
+    double sumL = 0;
+    double sumR = 0;
+    for (size_t k = 0; k < nBand_; ++k) {
+      auto band = mixStereo(filter.output[k][0], filter.output[k][1], stereoSpread_[k]);
+      sumL += band[0];
+      sumR += band[1];
+    }
 
-    out0[i] = float(lower[0] + upper[0]);
-    out1[i] = float(lower[1] + upper[1]);
+    out0[i] = float(sumL);
+    out1[i] = float(sumR);
   }
 }
 
+void DSPCore::process(const size_t length, const float* in0, const float* in1, float* out0,
+                      float* out1) {
+  std::visit(
+    [&](auto& crossover) { processBlock(crossover, length, in0, in1, out0, out1); }, crossover_);
+}
+
 } // namespace Uhhyou
@@ -11,6 +11,8 @@
 #include <array>
 #include <cstdint>
 #include <random>
+#include <utility>
+#include <variant>
 
 namespace Uhhyou {
 
@@ -33,13 +35,49 @@ public:
   void process(const size_t length, const float* in0, const float* in1, float* out0, float* out1);
 
 private:
+  static constexpr size_t maxBand = 6;
+
+  // Order and stage decide the sizes of delays, so each pair is a separate type. Stage is the
+  // truncation length of the reversed IIR in power of 2. Higher stage is more accurate at low
+  // crossover frequency, at the cost of latency.
+  static constexpr std::array<size_t, 2> crossoverOrders{4, 8};
+  static constexpr std::array<size_t, 3> crossoverStages{6, 8, 10};
+  static constexpr size_t nCrossover = crossoverOrders.size() * crossoverStages.size();
+
+  template<size_t order, size_t stage> struct StereoCrossover {
+    // Left and right channels are processed as 2 lanes of one filter.
+    using Filter = LinkwitzRileyFIRNBand<double, order, stage, maxBand, 2>;
+
+    std::array<typename Filter::Coefficient, maxBand - 1> coefficient;
+    Filter filter;
+  };
+
+  // Index is `orderIndex * crossoverStages.size() + stageIndex`.
+  template<size_t index>
+  using StereoCrossoverAt = StereoCrossover<crossoverOrders[index / crossoverStages.size()],
+                                            crossoverStages[index % crossoverStages.size()]>;
+
+  template<size_t... index>
+  static std::variant<StereoCrossoverAt<index>...>
+  makeCrossoverVariant(std::index_sequence<index...>);
+
+  using CrossoverVariant = decltype(makeCrossoverVariant(std::make_index_sequence<nCrossover>{}));
+
+  size_t crossoverIndex();
+  void selectCrossover(size_t index);
+  void setBandCount(size_t nBand);
+
+  template<typename Crossover>
+  void processBlock(Crossover& crossover, const size_t length, const float* in0, const float* in1,
+                    float* out0, float* out1);
+
   double sampleRate_ = 44100;
 
   SmootherParameter<double> smoo_;
-  ExpSmoother<double> crossoverFreq_{smoo_};
-  ExpSmoother<double> lowerStereoSpread_{smoo_};
-  ExpSmoother<double> upperStereoSpread_{smoo_};
-  std::array<LinkwitzRileyFIR2Band4n<double, 4, 8>, 2> crossoverFilter_;
+  size_t nBand_ = 2;
+  ParallelExpSmoother<double, maxBand - 1> crossoverFreq_{smoo_};
+  ParallelExpSmoother<double, maxBand> stereoSpread_{smoo_};
+  CrossoverVariant crossover_;
 };
 
 } // namespace Uhhyou
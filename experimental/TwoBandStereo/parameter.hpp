@@ -28,11 +28,25 @@ struct Scales {
 
   DecibelScl gain{float(-60), float(60), true};
   DecibelScl crossoverHz{float(20), float(86.0206), false}; // 10-20000 Hz.
+  UIntScl bandCount{4}; // 2 to 6 bands.
+  UIntScl crossoverOrder{1};
+  UIntScl crossoverAccuracy{2};
 };
 
 struct ValueReceivers {
+  std::atomic<float>* bandCount{};
   std::atomic<float>* crossoverHz{};
+  std::atomic<float>* crossoverHz1{};
+  std::atomic<float>* crossoverHz2{};
+  std::atomic<float>* crossoverHz3{};
+  std::atomic<float>* crossoverHz4{};
+  std::atomic<float>* crossoverOrder{};
+  std::atomic<float>* crossoverAccuracy{};
   std::atomic<float>* upperStereoSpread{};
+  std::atomic<float>* midStereoSpread1{};
+  std::atomic<float>* midStereoSpread2{};
+  std::atomic<float>* midStereoSpread3{};
+  std::atomic<float>* midStereoSpread4{};
   std::atomic<float>* lowerStereoSpread{};
 
   // Internal values used for GUI.
@@ -71,16 +85,71 @@ private:
 
     auto generalGroup = createParameterGroup("generalGroup");
 
+    value.bandCount
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::UIntScl>>(
+                       0.0f, scale.bandCount, "bandCount", "Bands", Cat::genericParameter,
+                       version0));
     value.crossoverHz
       = addParameter(generalGroup,
                      std::make_unique<ScaledParameter<Scales::DecibelScl>>(
                        scale.crossoverHz.invmap(200), scale.crossoverHz, "crossoverHz", "Crossover",
                        Cat::genericParameter, version0, "Hz", Rep::raw));
+    value.crossoverHz1
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::DecibelScl>>(
+                       scale.crossoverHz.invmap(800), scale.crossoverHz, "crossoverHz1",
+                       "Crossover 2", Cat::genericParameter, version0, "Hz", Rep::raw));
+    value.crossoverHz2
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::DecibelScl>>(
+                       scale.crossoverHz.invmap(2000), scale.crossoverHz, "crossoverHz2",
+                       "Crossover 3", Cat::genericParameter, version0, "Hz", Rep::raw));
+    value.crossoverHz3
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::DecibelScl>>(
+                       scale.crossoverHz.invmap(5000), scale.crossoverHz, "crossoverHz3",
+                       "Crossover 4", Cat::genericParameter, version0, "Hz", Rep::raw));
+    value.crossoverHz4
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::DecibelScl>>(
+                       scale.crossoverHz.invmap(12000), scale.crossoverHz, "crossoverHz4",
+                       "Crossover 5", Cat::genericParameter, version0, "Hz", Rep::raw));
+    value.crossoverOrder
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::UIntScl>>(
+                       0.0f, scale.crossoverOrder, "crossoverOrder", "Order",
+                       Cat::genericParameter, version0));
+    value.crossoverAccuracy
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::UIntScl>>(
+                       scale.crossoverAccuracy.invmap(1), scale.crossoverAccuracy,
+                       "crossoverAccuracy", "Accuracy", Cat::genericParameter, version0));
     value.upperStereoSpread
       = addParameter(generalGroup,
                      std::make_unique<ScaledParameter<Scales::LinearScl>>(
                        1.0f, scale.unipolar, "upperStereoSpread", "Upper Spread",
                        Cat::genericParameter, version0, "", Rep::raw));
+    value.midStereoSpread1
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::LinearScl>>(
+                       1.0f, scale.unipolar, "midStereoSpread1", "Mid 1 Spread",
+                       Cat::genericParameter, version0, "", Rep::raw));
+    value.midStereoSpread2
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::LinearScl>>(
+                       1.0f, scale.unipolar, "midStereoSpread2", "Mid 2 Spread",
+                       Cat::genericParameter, version0, "", Rep::raw));
+    value.midStereoSpread3
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::LinearScl>>(
+                       1.0f, scale.unipolar, "midStereoSpread3", "Mid 3 Spread",
+                       Cat::genericParameter, version0, "", Rep::raw));
+    value.midStereoSpread4
+      = addParameter(generalGroup,
+                     std::make_unique<ScaledParameter<Scales::LinearScl>>(
+                       1.0f, scale.unipolar, "midStereoSpread4", "Mid 4 Spread",
+                       Cat::genericParameter, version0, "", Rep::raw));
     value.lowerStereoSpread
       = addParameter(generalGroup,
                      std::make_unique<ScaledParameter<Scales::LinearScl>>(
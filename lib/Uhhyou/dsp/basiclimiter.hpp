@@ -3,10 +3,12 @@
 
 #pragma once
 
-#include "Uhhyou/dsp/smoother.hpp"
+#include "smoother.hpp"
 
 #include <algorithm>
-#include <random>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 namespace Uhhyou {
@@ -71,7 +73,9 @@ public:
     rptr_ = 0;
   }
 
-  void reset() { std::fill(buf_.begin(), buf_.end(), Sample(0)); }
+  size_t bufferBytes() const { return buf_.size() * sizeof(Sample); }
+
+  void reset() { std::fill(buf_.begin(), buf_.end(), Sample{}); }
 
   void setFrames(size_t delayFrames) {
     if (delayFrames >= buf_.size()) { delayFrames = buf_.size(); }
@@ -104,6 +108,8 @@ template<typename T> struct RingQueue {
     rptr = 0;
   }
 
+  size_t bufferBytes() const { return buf.size() * sizeof(T); }
+
   void reset(T value = 0) {
     std::fill(buf.begin(), buf.end(), value);
     wptr = 0;
@@ -170,6 +176,8 @@ template<typename Sample> struct PeakHold {
     queue.resize(size);
   }
 
+  size_t bufferBytes() const { return delay.bufferBytes() + queue.bufferBytes(); }
+
   void reset() {
     delay.reset();
     queue.reset();
@@ -203,6 +211,8 @@ public:
     delay2_.resize(size / 2);
   }
 
+  size_t bufferBytes() const { return delay1_.bufferBytes() + delay2_.bufferBytes(); }
+
   void reset() {
     sum1_ = 0;
     sum2_ = 0;
@@ -246,7 +256,9 @@ public:
   }
 };
 
-template<typename Sample, bool fastSmoothing = true> class BasicLimiter {
+// Gain envelope of a lookahead limiter. Input is the absolute value of the signal to be delayed
+// by `attackFrames()`.
+template<typename Sample, bool fastSmoothing = true> class LimiterGainEnvelope {
 private:
   size_t attackFrames_ = 0;
   Sample thresholdAmp_ = Sample(1); // thresholdAmp > 0.
@@ -254,32 +266,32 @@ private:
   PeakHold<Sample> peakhold_;
   DoubleAverageFilter<double, fastSmoothing> smoother_;
   LimiterReleaseFilter<Sample> releaseFilter_;
-  IntDelay<Sample> lookaheadDelay_;
 
 public:
-  size_t latency(size_t upfold) { return attackFrames_ / upfold; }
+  size_t attackFrames() const { return attackFrames_; }
 
   void resize(size_t size) {
-    size += size % 2; // DoubleAverageFilter requires multiple of 2.
     peakhold_.resize(size);
     smoother_.resize(size);
-    lookaheadDelay_.resize(size);
   }
 
+  size_t bufferBytes() const { return peakhold_.bufferBytes() + smoother_.bufferBytes(); }
+
   void reset() {
     peakhold_.reset();
     smoother_.reset();
     releaseFilter_.reset(Sample(1));
-    lookaheadDelay_.reset();
   }
 
-  void prepare(Sample sampleRate, Sample attackSeconds, Sample releaseSeconds,
+  // Returns true when attack time is changed. In this case, envelope is reset.
+  bool prepare(Sample sampleRate, Sample attackSeconds, Sample releaseSeconds,
                Sample thresholdAmplitude) {
     auto prevAttack = attackFrames_;
     attackFrames_ = size_t(sampleRate * attackSeconds + Sample(0.5));
     attackFrames_ += attackFrames_ % 2; // DoubleAverageFilter requires multiple of 2.
 
-    if (prevAttack != attackFrames_) { reset(); }
+    const bool isAttackChanged = prevAttack != attackFrames_;
+    if (isAttackChanged) { reset(); }
 
     releaseFilter_.setSecond(sampleRate, releaseSeconds);
 
@@ -287,7 +299,7 @@ public:
 
     peakhold_.setFrames(attackFrames_);
     smoother_.setFrames(attackFrames_);
-    lookaheadDelay_.setFrames(attackFrames_);
+    return isAttackChanged;
   }
 
   inline Sample applyCharacteristicCurve(Sample peakAmp) {
@@ -299,15 +311,98 @@ public:
     return releaseFilter_.process(gain);
   }
 
-  Sample process(Sample input) {
-    auto inAbs = std::fabs(input);
+  Sample process(Sample inAbs) {
     auto peakAmp = peakhold_.process(inAbs);
     auto candidate = applyCharacteristicCurve(peakAmp);
     auto released = processRelease(candidate);
     auto gainAmp = std::min(released, candidate);
-    auto smoothed = smoother_.process(gainAmp);
-    auto delayed = lookaheadDelay_.process(input);
-    return smoothed * delayed;
+    return Sample(smoother_.process(gainAmp));
+  }
+};
+
+template<typename Sample, bool fastSmoothing = true> class BasicLimiter {
+private:
+  LimiterGainEnvelope<Sample, fastSmoothing> envelope_;
+  IntDelay<Sample> lookaheadDelay_;
+
+public:
+  size_t latency(size_t upfold) { return envelope_.attackFrames() / upfold; }
+
+  void resize(size_t size) {
+    size += size % 2; // DoubleAverageFilter requires multiple of 2.
+    envelope_.resize(size);
+    lookaheadDelay_.resize(size);
+  }
+
+  size_t bufferBytes() const { return envelope_.bufferBytes() + lookaheadDelay_.bufferBytes(); }
+
+  void reset() {
+    envelope_.reset();
+    lookaheadDelay_.reset();
+  }
+
+  void prepare(Sample sampleRate, Sample attackSeconds, Sample releaseSeconds,
+               Sample thresholdAmplitude) {
+    if (envelope_.prepare(sampleRate, attackSeconds, releaseSeconds, thresholdAmplitude)) {
+      lookaheadDelay_.reset();
+    }
+    lookaheadDelay_.setFrames(envelope_.attackFrames());
+  }
+
+  Sample process(Sample input) {
+    auto gain = envelope_.process(std::fabs(input));
+    return gain * lookaheadDelay_.process(input);
+  }
+};
+
+/*
+Limiter with linked channels. Gain is computed from the maximum absolute value across channels,
+and the same gain is applied to all channels. Compared to `nChannel` of `BasicLimiter`, peak hold
+and smoothing runs only once, and stereo image doesn't shift when one channel is limited.
+*/
+template<typename Sample, size_t nChannel, bool fastSmoothing = true> class LinkedLimiter {
+private:
+  LimiterGainEnvelope<Sample, fastSmoothing> envelope_;
+  std::array<IntDelay<Sample>, nChannel> lookaheadDelay_;
+
+public:
+  size_t latency(size_t upfold) { return envelope_.attackFrames() / upfold; }
+
+  void resize(size_t size) {
+    size += size % 2; // DoubleAverageFilter requires multiple of 2.
+    envelope_.resize(size);
+    for (auto& x : lookaheadDelay_) { x.resize(size); }
+  }
+
+  size_t bufferBytes() const {
+    size_t bytes = envelope_.bufferBytes();
+    for (const auto& x : lookaheadDelay_) { bytes += x.bufferBytes(); }
+    return bytes;
+  }
+
+  void reset() {
+    envelope_.reset();
+    for (auto& x : lookaheadDelay_) { x.reset(); }
+  }
+
+  void prepare(Sample sampleRate, Sample attackSeconds, Sample releaseSeconds,
+               Sample thresholdAmplitude) {
+    if (envelope_.prepare(sampleRate, attackSeconds, releaseSeconds, thresholdAmplitude)) {
+      for (auto& x : lookaheadDelay_) { x.reset(); }
+    }
+    for (auto& x : lookaheadDelay_) { x.setFrames(envelope_.attackFrames()); }
+  }
+
+  std::array<Sample, nChannel> process(const std::array<Sample, nChannel>& input) {
+    Sample inAbs = 0;
+    for (size_t ch = 0; ch < nChannel; ++ch) { inAbs = std::max(inAbs, std::fabs(input[ch])); }
+    auto gain = envelope_.process(inAbs);
+
+    std::array<Sample, nChannel> output;
+    for (size_t ch = 0; ch < nChannel; ++ch) {
+      output[ch] = gain * lookaheadDelay_[ch].process(input[ch]);
+    }
+    return output;
   }
 };
 
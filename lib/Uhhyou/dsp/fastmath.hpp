@@ -0,0 +1,204 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+/*
+Polynomial approximations of transcendental functions for per-sample use.
+
+Functions have no branch and no call to libm, so that loops over them can be vectorized. Explicit
+intrinsics are not used, because plugins are built for both x86_64 and arm64.
+
+Polynomial coefficients are minimax fits for `double`. Errors below are the approximation errors of
+the polynomials, computed in `long double` over the reduced range of input. They don't depend on
+platform. Rounding in `double` adds a few ulp on top of them, which is checked in
+`tools/fastmathtest`. For `float`, the error is bounded by rounding of `float` instead.
+
+NaN input is not supported.
+
+These are not always faster than libm. In scalar code with `-ffast-math`, `std::exp`,
+`std::exp2` and `std::erf` of glibc are as fast or faster. Check timings of `tools/fastmathtest`
+before replacing a call.
+*/
+
+namespace Uhhyou {
+namespace FastMath {
+
+template<typename T> struct FloatTraits;
+
+template<> struct FloatTraits<float> {
+  using Int = int32_t;
+  static constexpr int mantissaBits = 23;
+  static constexpr int bias = 127;
+};
+
+template<> struct FloatTraits<double> {
+  using Int = int64_t;
+  static constexpr int mantissaBits = 52;
+  static constexpr int bias = 1023;
+};
+
+// `sin(x) / x` as a polynomial of `s = x * x`, for `x` in [0, pi/2].
+template<typename T> inline T sinKernel(T s) {
+  return T(9.999999999788489868217e-01)
+    + s
+    * (T(-1.666666660882606991809e-01)
+       + s
+         * (T(8.333330720557748187219e-03)
+            + s
+              * (T(-1.984083282326383173156e-04)
+                 + s * (T(2.752397107474148768568e-06) + s * T(-2.386834652306930862736e-08)))));
+}
+
+/*
+2^x. Maximum relative error is 4.03e-11.
+
+Input is clamped to the range of normal numbers, [-1022, 1023] for `double` and [-126, 127] for
+`float`.
+*/
+template<typename T> inline T exp2(T x) {
+  using Traits = FloatTraits<T>;
+  using Int = typename Traits::Int;
+
+  x = std::min(T(Traits::bias), std::max(T(1 - Traits::bias), x));
+
+  // `x + bias` is positive, so truncation is floor.
+  const int32_t biased = int32_t(x + T(Traits::bias));
+  const T f = x - T(biased - Traits::bias);
+
+  const T p = T(9.999999999597889835173e-01)
+    + f
+      * (T(6.931471860838887160718e-01)
+         + f
+           * (T(2.402263846180049454377e-01)
+              + f
+                * (T(5.550512685953362812196e-02)
+                   + f
+                     * (T(9.614017011913763379366e-03)
+                        + f
+                          * (T(1.342263482395515575641e-03)
+                             + f
+                               * (T(1.435231403458322842040e-04)
+                                  + f * T(2.149876370658270480682e-05)))))));
+
+  return p * std::bit_cast<T>(Int(biased) << Traits::mantissaBits);
+}
+
+// e^x. Maximum relative error is 4.03e-11 plus `|x| * 1.1e-16` from scaling to base 2.
+template<typename T> inline T exp(T x) { return exp2(x * std::numbers::log2e_v<T>); }
+
+/*
+Error function. Maximum absolute error is 1.89e-10, which is 1.83e-10 of `r(t)` below plus the
+error of `exp` scaled by `erfc(1)`. Maximum relative error is 3.33e-11 for `|x| < 1`. Relative
+accuracy near 0 is kept, so `erf(x) / x` is usable for small `x`.
+*/
+template<typename T> inline T erf(T x) {
+  const T ax = std::min(std::abs(x), T(6));
+  const T s = ax * ax;
+
+  // `|x| < 1`: erf(x) = x * q(x^2).
+  const T small = ax
+    * (T(1.128379167058022681039e+00)
+       + s
+         * (T(-3.761263843465518817504e-01)
+            + s
+              * (T(1.128378197417138929375e-01)
+                 + s
+                   * (T(-2.686540004606623823735e-02)
+                      + s
+                        * (T(5.220945443957767503419e-03)
+                           + s
+                             * (T(-8.482829007995511746285e-04)
+                                + s
+                                  * (T(1.125694908885256462325e-04)
+                                     + s * T(-9.641519448683353790910e-06))))))));
+
+  // `|x| >= 1`: erf(x) = 1 - exp(-x^2) * r(t), where t = 1 / (1 + x / 2).
+  const T t = T(1) / (T(1) + T(0.5) * ax);
+  const T r = T(-2.908966714035211022245e-05)
+    + t
+      * (T(2.827156622624182582746e-01)
+         + t
+           * (T(2.764127631810327199470e-01)
+              + t
+                * (T(2.757187915518806383449e-01)
+                   + t
+                     * (T(8.873379302997365438577e-02)
+                        + t
+                          * (T(2.378990263393633390881e-01)
+                             + t
+                               * (T(-1.304520503080889561406e-01)
+                                  + t
+                                    * (T(-8.265934792288922179751e-02)
+                                       + t * T(5.191119073874696968103e-02))))))));
+  const T large = T(1) - exp(-s) * r;
+
+  return std::copysign(ax < T(1) ? small : large, x);
+}
+
+/*
+tan(x) for `x` in (-pi/2, pi/2). Maximum relative error is 4.1e-11, plus the rounding of
+`pi/2 - |x|` relative to itself as `x` approaches pi/2.
+*/
+template<typename T> inline T tan(T x) {
+  constexpr T halfPi = std::numbers::pi_v<T> / T(2);
+  const T c = halfPi - std::abs(x);
+  return x * sinKernel(x * x) / (c * sinKernel(c * c));
+}
+
+// cos(x) for `|x| < 2^31 * 2 * pi`. Maximum absolute error is 2.12e-11, plus
+// `|x| * 2.2e-16` from the reduction.
+template<typename T> inline T cos(T x) {
+  // Reduce to `r` in [0, 1) cycle.
+  const T u = x * (T(0.5) / std::numbers::pi_v<T>);
+  int32_t n = int32_t(u);
+  n -= int32_t(u < T(n));
+  const T r = u - T(n);
+
+  // cos(2 pi r) = sin(2 pi (1/4 - a)), where `a` is in [0, 1/2].
+  const T a = r > T(0.5) ? T(1) - r : r;
+  const T w = T(2) * std::numbers::pi_v<T> * (T(0.25) - a);
+  return w * sinKernel(w * w);
+}
+
+// atan2(y, x). Maximum absolute error is 8.13e-12. Returns 0 when both are 0.
+template<typename T> inline T atan2(T y, T x) {
+  constexpr T pi = std::numbers::pi_v<T>;
+
+  const T ax = std::abs(x);
+  const T ay = std::abs(y);
+  const T t = std::min(ax, ay) / std::max(std::max(ax, ay), std::numeric_limits<T>::min());
+
+  // Reduce to [0, tan(pi/8)] by atan(t) = pi/4 + atan((t - 1) / (t + 1)).
+  const bool isReduced = t > std::numbers::sqrt2_v<T> - T(1);
+  const T v = isReduced ? (t - T(1)) / (t + T(1)) : t;
+  const T s = v * v;
+  const T atanV = v
+    * (T(9.999999999792976938654e-01)
+       + s
+         * (T(-3.333333213495447762572e-01)
+            + s
+              * (T(1.999988637803712945515e-01)
+                 + s
+                   * (T(-1.428165114773364922636e-01)
+                      + s
+                        * (T(1.104118751017830519056e-01)
+                           + s
+                             * (T(-8.459798864908515267304e-02)
+                                + s * T(4.714335381057921015819e-02)))))));
+
+  T theta = isReduced ? pi / T(4) + atanV : atanV;
+  theta = ay > ax ? pi / T(2) - theta : theta;
+  theta = x < T(0) ? pi - theta : theta;
+  return std::copysign(theta, y);
+}
+
+} // namespace FastMath
+} // namespace Uhhyou
@@ -0,0 +1,117 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Uhhyou {
+
+/**
+Processing time of each block relative to the duration of the block, which is the deadline. Load of
+1.0 means the block took as long as it plays.
+
+Counters are only written by the audio thread, so plain load and store are used instead of
+read-modify-write. GUI requests a reset, and the audio thread clears counters at the next block.
+Readers may see counters from different blocks, which is acceptable for display.
+*/
+class LoadMeter {
+public:
+  static constexpr size_t nBin = 256;
+  static constexpr double binWidth = 0.005; // Last bin holds all loads above 127.5%.
+
+  struct Snapshot {
+    uint64_t count = 0;
+    double average = 0;
+    double peak = 0;
+    double percentile99 = 0; // Upper edge of the bin.
+  };
+
+  // Measures the time until destruction.
+  class ScopedMeasure {
+  public:
+    ScopedMeasure(LoadMeter& meter, int nFrame, double sampleRate)
+        : meter_(meter), start_(Clock::now()),
+          deadlineSecond_(sampleRate > 0 ? double(nFrame) / sampleRate : 0) {}
+
+    ~ScopedMeasure() {
+      const std::chrono::duration<double> elapsed = Clock::now() - start_;
+      meter_.add(elapsed.count(), deadlineSecond_);
+    }
+
+    ScopedMeasure(const ScopedMeasure&) = delete;
+    ScopedMeasure& operator=(const ScopedMeasure&) = delete;
+
+  private:
+    LoadMeter& meter_;
+    std::chrono::steady_clock::time_point start_;
+    double deadlineSecond_;
+  };
+
+  // Audio thread only.
+  void add(double elapsedSecond, double deadlineSecond) {
+    if (resetRequested_.exchange(false, std::memory_order_acquire)) { clear(); }
+    if (deadlineSecond <= 0) { return; }
+
+    const double load = elapsedSecond / deadlineSecond;
+
+    const auto bin = load < double(nBin - 1) * binWidth ? size_t(load / binWidth) : nBin - 1;
+    increment(histogram_[bin]);
+    increment(count_);
+    sum_.store(sum_.load(std::memory_order_relaxed) + load, std::memory_order_relaxed);
+    if (load > peak_.load(std::memory_order_relaxed)) {
+      peak_.store(load, std::memory_order_relaxed);
+    }
+  }
+
+  // Any thread.
+  void requestReset() { resetRequested_.store(true, std::memory_order_release); }
+
+  // Any thread.
+  Snapshot getSnapshot() const {
+    Snapshot snap;
+    snap.count = count_.load(std::memory_order_relaxed);
+    if (snap.count == 0) { return snap; }
+
+    snap.average = sum_.load(std::memory_order_relaxed) / double(snap.count);
+    snap.peak = peak_.load(std::memory_order_relaxed);
+
+    uint64_t total = 0;
+    for (const auto& h : histogram_) { total += h.load(std::memory_order_relaxed); }
+    const uint64_t target = total - total / 100;
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < nBin; ++i) {
+      cumulative += histogram_[i].load(std::memory_order_relaxed);
+      if (cumulative >= target) {
+        snap.percentile99 = i == nBin - 1 ? snap.peak : double(i + 1) * binWidth;
+        break;
+      }
+    }
+    return snap;
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  std::array<std::atomic<uint32_t>, nBin> histogram_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<double> sum_{0};
+  std::atomic<double> peak_{0};
+  std::atomic<bool> resetRequested_{false};
+
+  template<typename T> static void increment(std::atomic<T>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  void clear() {
+    for (auto& h : histogram_) { h.store(0, std::memory_order_relaxed); }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    peak_.store(0, std::memory_order_relaxed);
+  }
+};
+
+} // namespace Uhhyou
@@ -0,0 +1,74 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Uhhyou {
+
+/**
+Wait-free single-producer single-consumer queue of fixed-size records, to send per-block values
+from DSP to GUI.
+
+Audio thread calls `push` once per block. GUI drains all records once per frame, so that an event
+shorter than a frame is not lost. When GUI is not draining (for example, editor is closed), `push`
+drops the new record and counts it instead of blocking. Storage is allocated in place, and nothing
+is allocated after construction.
+
+`Record` must be trivially copyable. Decimated audio can be carried as a fixed size `std::array`
+in `Record`.
+
+Head and tail are on separate cache lines, so that producer and consumer don't invalidate each
+other's line on every access.
+*/
+template<typename Record, size_t capacity = 256> class TelemetryRing {
+private:
+  static_assert(std::is_trivially_copyable_v<Record>);
+  static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0,
+                "Capacity must be a power of 2");
+
+  static constexpr size_t mask = capacity - 1;
+  static constexpr size_t cacheLineSize = 64;
+
+  alignas(cacheLineSize) std::atomic<size_t> head_{0}; // Written by producer.
+  alignas(cacheLineSize) std::atomic<size_t> tail_{0}; // Written by consumer.
+  alignas(cacheLineSize) std::atomic<uint64_t> dropped_{0};
+  std::array<Record, capacity> buffer_{};
+
+public:
+  // Producer only. Returns false when the queue is full.
+  bool push(const Record& record) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= capacity) {
+      dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+    buffer_[head & mask] = record;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Calls `fn(const Record&)` on each record in the order of push, and returns the
+  // number of records.
+  template<typename Fn> size_t drain(Fn&& fn) {
+    const size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t count = head - tail;
+    for (; tail != head; ++tail) { fn(buffer_[tail & mask]); }
+    tail_.store(tail, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer only. Discards stale records, for example, when an editor is opened.
+  void clear() { tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release); }
+
+  // Any thread.
+  uint64_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+};
+
+} // namespace Uhhyou
@@ -0,0 +1,206 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Uhhyou {
+
+class AnimatedComponent;
+class AnimationSource;
+
+/**
+Drives all `AnimatedComponent` in the process from one vblank callback.
+
+On each vblank, `AnimationSource` are called first to receive new values, for example, by draining
+a `TelemetryRing` or by delivering parameter changes. Then `AnimatedComponent::advance` is called on
+each showing component, and the components that are changed get `repaint`.
+
+- When no component is changed for `idleAfterMs`, frame rate of `AnimatedComponent` drops to
+  `1000 / idleIntervalMs` Hz until a change appears. Sources are still called on every vblank.
+- Repaint is limited to `paintBudgetMs` per frame, estimated from the measured `paint` time of each
+  component. Components over the budget are deferred to the next frame, and the ones waited longer
+  are repainted first. At least one component is repainted on each frame.
+- The vblank callback is removed when no component or source is left.
+*/
+class AnimationScheduler {
+private:
+  static constexpr uint32_t idleAfterMs = 500;
+  static constexpr uint32_t idleIntervalMs = 100;
+  static constexpr double paintBudgetMs = 6;
+
+  std::vector<AnimatedComponent*> components_;
+  std::vector<AnimationSource*> sources_;
+  std::vector<AnimatedComponent*> dirty_;
+  std::vector<juce::Component*> hosts_;
+  std::unique_ptr<juce::VBlankAttachment> vblank_;
+  juce::Component* host_ = nullptr;
+
+  uint32_t lastFrameMs_ = 0;
+  uint32_t unchangedMs_ = 0;
+  uint64_t frame_ = 0;
+
+  AnimationScheduler() = default;
+
+  inline void addHost(juce::Component* host);
+  inline void removeHost(juce::Component* host);
+  inline void onVBlank();
+
+public:
+  static AnimationScheduler& getInstance() {
+    static AnimationScheduler instance;
+    return instance;
+  }
+
+  inline void add(AnimatedComponent* component);
+  inline void remove(AnimatedComponent* component);
+  inline void add(AnimationSource* source);
+  inline void remove(AnimationSource* source);
+};
+
+/**
+Replacement of `juce::AnimatedAppComponent` that is driven by `AnimationScheduler`.
+
+`advance` is the counterpart of `update`. It returns `true` when the look is changed, so that the
+scheduler can skip `repaint` and drop frame rate. `paintFrame` is the counterpart of `paint`.
+*/
+class AnimatedComponent : public juce::Component {
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnimatedComponent)
+
+  friend class AnimationScheduler;
+
+  double paintCostMs_ = 0; // Smoothed duration of `paintFrame`.
+  uint64_t repaintedFrame_ = 0;
+  bool isDirty_ = false;
+
+public:
+  AnimatedComponent() { AnimationScheduler::getInstance().add(this); }
+  virtual ~AnimatedComponent() override { AnimationScheduler::getInstance().remove(this); }
+
+  // `elapsedMs` is the time since the last `advance`.
+  virtual bool advance(int elapsedMs) = 0;
+  virtual void paintFrame(juce::Graphics& ctx) = 0;
+
+  virtual void paint(juce::Graphics& ctx) override final {
+    const auto start = juce::Time::getHighResolutionTicks();
+    paintFrame(ctx);
+    const double elapsedMs = 1000
+      * juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    paintCostMs_ += double(0.125) * (elapsedMs - paintCostMs_);
+  }
+};
+
+/**
+Callback called on each vblank of `AnimationScheduler`, while this is alive.
+
+`host` is used to receive vblank, and it must outlive this. It's usually the owner of this.
+*/
+class AnimationSource {
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnimationSource)
+
+  friend class AnimationScheduler;
+
+  juce::Component& host_;
+  std::function<void()> onFrame_;
+
+public:
+  AnimationSource(juce::Component& host, std::function<void()> onFrame)
+      : host_(host), onFrame_(std::move(onFrame)) {
+    AnimationScheduler::getInstance().add(this);
+  }
+
+  ~AnimationSource() { AnimationScheduler::getInstance().remove(this); }
+};
+
+inline void AnimationScheduler::add(AnimatedComponent* component) {
+  components_.push_back(component);
+  addHost(component);
+}
+
+inline void AnimationScheduler::remove(AnimatedComponent* component) {
+  std::erase(components_, component);
+  std::erase(dirty_, component);
+  removeHost(component);
+}
+
+inline void AnimationScheduler::add(AnimationSource* source) {
+  sources_.push_back(source);
+  addHost(&source->host_);
+}
+
+inline void AnimationScheduler::remove(AnimationSource* source) {
+  std::erase(sources_, source);
+  removeHost(&source->host_);
+}
+
+// Vblank is received through one of the hosts. When it's removed, the most recently added host
+// takes over, which is likely in the editor opened last. A host may be added more than once.
+inline void AnimationScheduler::addHost(juce::Component* host) {
+  hosts_.push_back(host);
+  if (host_ != nullptr) { return; }
+  host_ = host;
+  vblank_ = std::make_unique<juce::VBlankAttachment>(host_, [this]() { onVBlank(); });
+  lastFrameMs_ = juce::Time::getMillisecondCounter();
+}
+
+inline void AnimationScheduler::removeHost(juce::Component* host) {
+  if (auto it = std::find(hosts_.rbegin(), hosts_.rend(), host); it != hosts_.rend()) {
+    hosts_.erase(std::next(it).base());
+  }
+  if (host_ != host || std::find(hosts_.begin(), hosts_.end(), host) != hosts_.end()) { return; }
+
+  vblank_.reset();
+  host_ = hosts_.empty() ? nullptr : hosts_.back();
+  if (host_ == nullptr) { return; }
+  vblank_ = std::make_unique<juce::VBlankAttachment>(host_, [this]() { onVBlank(); });
+}
+
+inline void AnimationScheduler::onVBlank() {
+  for (auto& source : sources_) { source->onFrame_(); }
+
+  const auto now = juce::Time::getMillisecondCounter();
+  const auto elapsedMs = now - lastFrameMs_;
+  if (unchangedMs_ >= idleAfterMs && elapsedMs < idleIntervalMs) { return; }
+  lastFrameMs_ = now;
+  ++frame_;
+
+  bool isChanged = false;
+  for (auto& component : components_) {
+    if (!component->isShowing()) { continue; }
+    if (component->advance(int(elapsedMs))) { component->isDirty_ = true; }
+    isChanged |= component->isDirty_;
+  }
+  unchangedMs_ = isChanged ? 0 : std::min(unchangedMs_ + elapsedMs, idleAfterMs);
+  if (!isChanged) { return; }
+
+  dirty_.clear();
+  for (auto& component : components_) {
+    if (component->isDirty_) { dirty_.push_back(component); }
+  }
+  std::sort(dirty_.begin(), dirty_.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs->repaintedFrame_ < rhs->repaintedFrame_;
+  });
+
+  double costMs = 0;
+  for (auto& component : dirty_) {
+    if (costMs > 0 && costMs + component->paintCostMs_ > paintBudgetMs) { continue; }
+    costMs += std::max(component->paintCostMs_, std::numeric_limits<double>::min());
+    component->isDirty_ = false;
+    component->repaintedFrame_ = frame_;
+    component->repaint();
+  }
+}
+
+} // namespace Uhhyou
@@ -88,7 +88,7 @@ public:
          std::string name)
       : editor_(editor), parameter_(parameter), scale_(scale), pal_(palette),
         attachment_(
-          parameter,
+          *this, parameter,
           [&](int index, float rawValue) {
             if (index < 0 && index >= value_.size()) { return; }
             auto normalized = scale_.invmap(rawValue);
@@ -0,0 +1,108 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_events/juce_events.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "animationscheduler.hpp"
+
+#include <atomic>
+#include <functional>
+#include <utility>
+
+namespace Uhhyou {
+
+/**
+This is basically `juce::ParameterAttachment`, but changes from other than message thread are
+delivered on vblank of `AnimationScheduler`.
+
+`juce::ParameterAttachment` posts a message for each parameter on each change. Under dense host
+automation on many parameters, it can saturate message thread with callbacks and `repaint`. Here,
+the change only stores the value and raises a flag. All the pending callbacks of an editor run in
+a single vblank callback, so the invalidated regions of the widgets are merged by the peer and
+painted once in the next frame. Intermediate values between frames are skipped.
+
+Changes on message thread, like mouse drag, are delivered immediately.
+
+`host` is passed to `AnimationSource`. It's usually the widget that owns this.
+*/
+class BatchedParameterAttachment : private juce::AudioProcessorParameter::Listener {
+public:
+  BatchedParameterAttachment(juce::Component& host, juce::RangedAudioParameter& parameter,
+                             std::function<void(float)> parameterChangedCallback,
+                             juce::UndoManager* undoManager = nullptr)
+      : parameter_(parameter), undoManager_(undoManager),
+        parameterChangedCallback_(std::move(parameterChangedCallback)),
+        source_(host, [this]() {
+          if (isPending_.exchange(false, std::memory_order_acquire)) { handleUpdate(); }
+        }) {
+    parameter_.addListener(this);
+  }
+
+  virtual ~BatchedParameterAttachment() override { parameter_.removeListener(this); }
+
+  void sendInitialUpdate() {
+    parameterValueChanged(parameter_.getParameterIndex(), parameter_.getValue());
+  }
+
+  void setValueAsCompleteGesture(float newRawValue) {
+    callIfParameterValueChanged(newRawValue, [this](float v) {
+      beginGesture();
+      parameter_.setValueNotifyingHost(v);
+      endGesture();
+    });
+  }
+
+  void beginGesture() {
+    if (undoManager_ != nullptr) { undoManager_->beginNewTransaction(); }
+    parameter_.beginChangeGesture();
+  }
+
+  void setValueAsPartOfGesture(float newRawValue) {
+    callIfParameterValueChanged(newRawValue,
+                                [this](float v) { parameter_.setValueNotifyingHost(v); });
+  }
+
+  void endGesture() { parameter_.endChangeGesture(); }
+
+private:
+  template<typename Callback>
+  void callIfParameterValueChanged(float newRawValue, Callback&& callback) {
+    const auto newValue = parameter_.convertTo0to1(newRawValue);
+    if (parameter_.getValue() != newValue) { callback(newValue); }
+  }
+
+  void parameterValueChanged(int, float newValue) override {
+    lastValue_.store(newValue, std::memory_order_relaxed);
+
+    if (juce::MessageManager::getInstance()->isThisTheMessageThread()) {
+      isPending_.store(false, std::memory_order_relaxed);
+      handleUpdate();
+    } else {
+      isPending_.store(true, std::memory_order_release);
+    }
+  }
+
+  void parameterGestureChanged(int, bool) override {}
+
+  void handleUpdate() {
+    if (parameterChangedCallback_ != nullptr) {
+      parameterChangedCallback_(
+        parameter_.convertFrom0to1(lastValue_.load(std::memory_order_relaxed)));
+    }
+  }
+
+  juce::RangedAudioParameter& parameter_;
+  juce::UndoManager* undoManager_ = nullptr;
+  std::function<void(float)> parameterChangedCallback_;
+  std::atomic<float> lastValue_{0};
+  std::atomic<bool> isPending_{false};
+  AnimationSource source_;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchedParameterAttachment)
+};
+
+} // namespace Uhhyou
@@ -8,6 +8,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include "../scaledparameter.hpp"
+#include "batchedparameterattachment.hpp"
 #include "numbereditor.hpp"
 #include "style.hpp"
 
@@ -181,7 +182,7 @@ protected:
   const juce::RangedAudioParameter* const parameter_;
 
   Scale& scale_;
-  juce::ParameterAttachment attachment_;
+  BatchedParameterAttachment attachment_;
 
   void showHostMenuNative(juce::Point<int> position) {
     if (auto* hostContext = editor_.getHostContext()) {
@@ -232,7 +233,7 @@ public:
       : ButtonBase<style>(editor, palette, statusBar, numberEditor, label, hint), editor_(editor),
         parameter_(parameter), scale_(scale),
         attachment_(
-          *parameter,
+          *this, *parameter,
           [&](float newRaw) {
             auto normalized = newRaw >= scale_.getMax() ? float(1) : float(0);
             setInternalValue(normalized);
@@ -293,7 +294,7 @@ protected:
   const juce::RangedAudioParameter* const parameter_;
 
   Scale& scale_;
-  juce::ParameterAttachment attachment_;
+  BatchedParameterAttachment attachment_;
 
   void showHostMenuNative(juce::Point<int> position) {
     if (auto* hostContext = editor_.getHostContext()) {
@@ -341,7 +342,7 @@ public:
       : ButtonBase<style>(editor, palette, statusBar, numberEditor, label, hint), editor_(editor),
         parameter_(parameter), scale_(scale),
         attachment_(
-          *parameter,
+          *this, *parameter,
           [&](float newRaw) {
             auto normalized = newRaw >= scale_.getMax() ? float(1) : float(0);
             setInternalValue(normalized);
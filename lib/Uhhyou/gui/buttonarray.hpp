@@ -48,7 +48,7 @@ public:
               std::array<juce::RangedAudioParameter*, nParameter> parameter, Scale& scale)
       : editor_(editor), parameter_(parameter), scale_(scale), pal_(palette),
         attachment_(
-          parameter,
+          *this, parameter,
           [&](int index, float rawValue) {
             if (index < 0 && index >= value_.size()) { return; }
             auto newValue = rawValue <= scale_.getMin() ? 0 : 1;
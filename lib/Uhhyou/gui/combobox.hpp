@@ -8,6 +8,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include "../scaledparameter.hpp"
+#include "batchedparameterattachment.hpp"
 #include "./numbereditor.hpp"
 #include "style.hpp"
 
@@ -84,7 +85,7 @@ protected:
   Palette& pal_;
   StatusBar& statusBar_;
   NumberEditor& numberEditor_;
-  juce::ParameterAttachment attachment_;
+  BatchedParameterAttachment attachment_;
 
   juce::PopupMenu menu_;
 
@@ -161,7 +162,7 @@ public:
       : editor_(editor), parameter_(parameter), scale_(scale), pal_(palette), statusBar_(statusBar),
         numberEditor_(numberEditor),
         attachment_(
-          *parameter,
+          *this, *parameter,
           [&](float newRaw) {
             size_t idx
               = static_cast<size_t>(std::max(0, static_cast<int>(std::floor(newRaw) + 0.5f)));
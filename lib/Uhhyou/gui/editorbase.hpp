@@ -40,6 +40,7 @@ public:
                          "Undo/Redo to revert.", [this]() { performRandomize(); }),
         presetManager_(*this, palette_, statusBar_, &(processor_.undoManager),
                        processor_.param.tree),
+        loadMeterButton_(*this, palette_, statusBar_, numberEditor_, processor_.loadMeter),
         settingsButton_(
           *this, palette_, statusBar_, numberEditor_, "GUI Settings", "Open settings menu",
           [this]() {
@@ -124,6 +125,11 @@ public:
     registerInteractive(redoButton_);
     registerInteractive(randomizeButton_);
     registerInteractive(presetManager_);
+    registerInteractive(loadMeterButton_);
+    if constexpr (requires { processor_.getMemoryFootprint(); }) {
+      loadMeterButton_.setMemoryFootprintGetter(
+        [this]() { return processor_.getMemoryFootprint(); });
+    }
     registerInteractive(settingsButton_);
     registerInteractive(pluginInfoButton_);
 
@@ -192,39 +198,30 @@ public:
   }
 
   void paintOverChildren(juce::Graphics& ctx) override {
-    int shadowSize = std::max(1, int(palette_.borderWidth()));
-    juce::DropShadow shadow(palette_.getForeground(palette_.background()), 4 * shadowSize,
-                            {0, shadowSize});
-
-    auto drawShadowIfHovered = [&](juce::Component& cmp) -> bool {
-      if (!cmp.isVisible() || !(cmp.isMouseOverOrDragging(true) || cmp.hasKeyboardFocus(false))) {
-        return false;
-      }
-      auto bounds = getLocalArea(&cmp, cmp.getLocalBounds());
-      juce::Graphics::ScopedSaveState save(ctx);
-      ctx.excludeClipRegion(bounds);
-      if (tooltipWindow_.isVisible()) { ctx.excludeClipRegion(tooltipWindow_.getBounds()); }
-
-      for (auto& safeDrawer : managedDrawers_) {
-        if (auto* drawer = safeDrawer.getComponent()) {
-          if (&cmp == &(drawer->getToggleButton())) {
-            bounds = getLocalArea(drawer, drawer->getLocalBounds());
-            ctx.excludeClipRegion(
-              juce::Rectangle<int>(bounds.getX(), 0, getWidth() - bounds.getX(), getHeight()));
-            break;
-          }
-        }
-      }
+    auto* target = findShadowTarget();
+    if (target == nullptr) { return; }
+
+    auto bounds = getLocalArea(target, target->getLocalBounds());
+    juce::Graphics::ScopedSaveState save(ctx);
+    ctx.excludeClipRegion(bounds);
+    if (tooltipWindow_.isVisible()) { ctx.excludeClipRegion(tooltipWindow_.getBounds()); }
+
+    if (auto* drawer = findDrawerOf(*target)) {
+      bounds = getLocalArea(drawer, drawer->getLocalBounds());
+      ctx.excludeClipRegion(
+        juce::Rectangle<int>(bounds.getX(), 0, getWidth() - bounds.getX(), getHeight()));
+    }
 
-      shadow.drawForRectangle(ctx, bounds);
-      return true;
-    };
+    makeShadow().drawForRectangle(ctx, bounds);
+  }
 
-    for (auto& safePtr : mainScope_.components) {
-      if (auto* cmp = safePtr.getComponent()) {
-        if (drawShadowIfHovered(*cmp)) { break; }
-      }
-    }
+  // Area covered by the hover shadow of `cmp` in the coordinate of this editor.
+  juce::Rectangle<int> getShadowArea(juce::Component& cmp) {
+    juce::Component* owner = findDrawerOf(cmp);
+    if (owner == nullptr) { owner = &cmp; }
+    const auto shadow = makeShadow();
+    const auto bounds = getLocalArea(owner, owner->getLocalBounds());
+    return (bounds.expanded(shadow.radius) + shadow.offset).getUnion(bounds).expanded(1);
   }
 
   virtual void mouseDown(const juce::MouseEvent& event) override {
@@ -238,15 +235,15 @@ public:
     // is started while dragging the edge of a plugin window. The issue is that the hidden cursor
     // fires mouse events. Same for `mouseExit`.
     event.source.enableUnboundedMouseMovement(false);
-    repaint();
+    updateShadow();
   }
 
   void mouseExit(const juce::MouseEvent& event) override {
     event.source.enableUnboundedMouseMovement(false);
-    repaint();
+    updateShadow();
   }
 
-  void globalFocusChanged(juce::Component*) override { repaint(); }
+  void globalFocusChanged(juce::Component*) override { updateShadow(); }
 
   bool keyPressed(const juce::KeyPress& key) override {
     if (key == juce::KeyPress::escapeKey) {
@@ -270,8 +267,8 @@ public:
     return nullptr;
   }
 
-  void focusGained(juce::Component::FocusChangeType) override { repaint(); }
-  void focusLost(juce::Component::FocusChangeType) override { repaint(); }
+  void focusGained(juce::Component::FocusChangeType) override { updateShadow(); }
+  void focusLost(juce::Component::FocusChangeType) override { updateShadow(); }
 
 protected:
   std::unique_ptr<juce::FileLogger> fileLogger_;
@@ -292,6 +289,7 @@ protected:
   ActionButton<> redoButton_;
   ActionButton<> randomizeButton_;
   PresetManager presetManager_;
+  LoadMeterButton loadMeterButton_;
   ActionButton<> settingsButton_;
   std::vector<GroupLabel> groupLabels_;
 
@@ -300,12 +298,51 @@ protected:
   std::unordered_map<juce::String, std::vector<ComponentSharedPtr>> sections_;
   std::vector<juce::Component::SafePointer<HorizontalDrawer>> managedDrawers_;
 
+  juce::Rectangle<int> shadowArea_; // Where the hover shadow was drawn last time.
+
   ParameterLockRegistry paramLocks_;
   std::unordered_map<const juce::AudioProcessorParameter*, juce::String> paramPtrToId_;
 
   using RandomizeFn = std::function<float(float)>;
   std::unordered_map<const juce::AudioProcessorParameter*, RandomizeFn> randomizers_;
 
+  juce::DropShadow makeShadow() {
+    int shadowSize = std::max(1, int(palette_.borderWidth()));
+    return juce::DropShadow(palette_.getForeground(palette_.background()), 4 * shadowSize,
+                            {0, shadowSize});
+  }
+
+  // Returns the first registered component that is hovered or focused.
+  juce::Component* findShadowTarget() {
+    for (auto& safePtr : mainScope_.components) {
+      auto* cmp = safePtr.getComponent();
+      if (cmp == nullptr || !cmp->isVisible()) { continue; }
+      if (cmp->isMouseOverOrDragging(true) || cmp->hasKeyboardFocus(false)) { return cmp; }
+    }
+    return nullptr;
+  }
+
+  // Toggle button of a drawer casts the shadow of the whole drawer.
+  HorizontalDrawer* findDrawerOf(juce::Component& cmp) {
+    for (auto& safeDrawer : managedDrawers_) {
+      if (auto* drawer = safeDrawer.getComponent()) {
+        if (&cmp == &(drawer->getToggleButton())) { return drawer; }
+      }
+    }
+    return nullptr;
+  }
+
+  // Repaints only the old and new area of the hover shadow. Widgets repaint themselves on hover
+  // and focus, so a repaint of the whole editor is not necessary.
+  void updateShadow() {
+    auto* target = findShadowTarget();
+    const auto area = target == nullptr ? juce::Rectangle<int>{} : getShadowArea(*target);
+    if (area == shadowArea_) { return; }
+    repaint(shadowArea_);
+    repaint(area);
+    shadowArea_ = area;
+  }
+
   virtual void performRandomize() {
     std::uniform_real_distribution<float> dist{0.0f, 1.0f};
     std::random_device dev;
@@ -380,6 +417,13 @@ protected:
     return nameTop0;
   }
 
+  // Places DSP load meter on the right end of `bounds`, and status bar on the rest.
+  void layoutStatusBar(juce::Rectangle<int> bounds, int margin, int meterWidth) {
+    loadMeterButton_.setBounds(bounds.removeFromRight(meterWidth));
+    bounds.removeFromRight(margin);
+    statusBar_.setBounds(bounds);
+  }
+
   void setGlobalKeyboardFocus(bool enable) {
     getStateTree().setProperty("KeyboardFocus", enable, nullptr);
 
@@ -8,10 +8,13 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include "../scaledparameter.hpp"
+#include "batchedparameterattachment.hpp"
+#include "layercache.hpp"
 #include "numbereditor.hpp"
 #include "style.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
 #include <limits>
@@ -79,7 +82,7 @@ protected:
   Palette& pal_;
   StatusBar& statusBar_;
   NumberEditor& numberEditor_;
-  juce::ParameterAttachment attachment_;
+  BatchedParameterAttachment attachment_;
 
   float value_{}; // Normalized in [0, 1].
   float defaultValue_{};
@@ -96,6 +99,14 @@ protected:
   juce::PathStrokeType arcStrokeType_;
   juce::PathStrokeType handStrokeType_;
 
+  // Arc and default value mark. Arc color depends on hover, so each state has its own layer, and
+  // moving the mouse across knobs doesn't rebuild them. Indexed by `isMouseEntered_`.
+  std::array<LayerCache, 2> staticLayers_;
+
+  void invalidateStaticLayers() {
+    for (auto& x : staticLayers_) { x.invalidate(); }
+  }
+
   void showHostMenuNative(juce::Point<int> position) {
     if (auto* hostContext = editor_.getHostContext()) {
       if (auto hostContextMenu = hostContext->getContextMenuForParameter(parameter_)) {
@@ -224,7 +235,7 @@ public:
            NumberEditor& numberEditor)
       : editor_(editor), parameter_(parameter), scale_(scale), pal_(palette), statusBar_(statusBar),
         numberEditor_(numberEditor), attachment_(
-                                       *parameter,
+                                       *this, *parameter,
                                        [&](float newRaw) {
                                          auto normalized = scale_.invmap(newRaw);
                                          setInternalValue(normalized);
@@ -266,8 +277,11 @@ public:
   virtual void resized() override {
     arcStrokeType_.setStrokeThickness(pal_.borderWidth() * 8.0f);
     handStrokeType_.setStrokeThickness(pal_.borderWidth() * 2.0f);
+    invalidateStaticLayers();
   }
 
+  virtual void lookAndFeelChanged() override { invalidateStaticLayers(); }
+
   virtual void mouseEnter(const juce::MouseEvent&) override {
     isMouseEntered_ = true;
     statusBar_.update(parameter_);
@@ -434,26 +448,32 @@ public:
 
   virtual void paint(juce::Graphics& ctx) override {
     const juce::Point<int> center{this->getWidth() / 2, this->getHeight() / 2};
-    ctx.setOrigin(center);
-
-    // Arc.
-    juce::Colour activeColor = this->isMouseEntered_ ? this->pal_.template getColor<style>()
-                                                     : this->pal_.border().withAlpha(0.3f);
-    ctx.setColour(activeColor);
-    constexpr auto twopi = 2 * std::numbers::pi_v<float>;
     const auto radius = center.x > center.y ? center.y : center.x;
-    juce::Path arc;
-    arc.addCentredArc(0, 0, radius, radius, 0, twopi * (0.5f + this->arcOpenPartRatio),
-                      twopi * (1.5f - this->arcOpenPartRatio), true);
-    ctx.strokePath(arc, this->arcStrokeType_);
-
-    // Mark for default value. Sharing color and style with hand.
     const float arcLineWidth = this->pal_.borderWidth() * 8.0f;
     const auto headLength = arcLineWidth / 2 - radius;
-    juce::Path mark;
-    mark.startNewSubPath(this->mapValueToHand(this->defaultValue_, headLength / 2));
-    mark.lineTo(this->mapValueToHand(this->defaultValue_, headLength));
-    ctx.strokePath(mark, this->handStrokeType_);
+
+    auto& layer = this->staticLayers_[size_t(this->isMouseEntered_)];
+    layer.draw(ctx, *this, false, 0, [&](juce::Graphics& g) {
+      g.setOrigin(center);
+
+      // Arc.
+      juce::Colour activeColor = this->isMouseEntered_ ? this->pal_.template getColor<style>()
+                                                       : this->pal_.border().withAlpha(0.3f);
+      g.setColour(activeColor);
+      constexpr auto twopi = 2 * std::numbers::pi_v<float>;
+      juce::Path arc;
+      arc.addCentredArc(0, 0, radius, radius, 0, twopi * (0.5f + this->arcOpenPartRatio),
+                        twopi * (1.5f - this->arcOpenPartRatio), true);
+      g.strokePath(arc, this->arcStrokeType_);
+
+      // Mark for default value. Sharing color and style with hand.
+      juce::Path mark;
+      mark.startNewSubPath(this->mapValueToHand(this->defaultValue_, headLength / 2));
+      mark.lineTo(this->mapValueToHand(this->defaultValue_, headLength));
+      g.strokePath(mark, this->handStrokeType_);
+    });
+
+    ctx.setOrigin(center);
 
     // Line from center to head.
     const auto headPoint = this->mapValueToHand(this->value_, headLength);
@@ -482,25 +502,31 @@ public:
 
   virtual void paint(juce::Graphics& ctx) override {
     const juce::Point<int> center{this->getWidth() / 2, this->getHeight() / 2};
-    ctx.setOrigin(center);
-
-    // Arc.
-    juce::Colour activeColor = this->isMouseEntered_ ? this->pal_.template getColor<style>()
-                                                     : this->pal_.border().withAlpha(0.3f);
-    ctx.setColour(activeColor);
     const auto radius = center.x > center.y ? center.y : center.x;
-    const auto rHalf = radius / 2;
-    juce::Path arc;
-    arc.addEllipse(-rHalf, -rHalf, rHalf, rHalf);
-    ctx.strokePath(arc, this->arcStrokeType_);
-
-    // Mark for default value. Sharing color and style with hand.
     const float arcLineWidth = this->pal_.borderWidth() * 8.0f;
     const auto headLength = arcLineWidth / 2 - radius;
-    juce::Path mark;
-    mark.startNewSubPath(this->mapValueToHand(this->defaultValue_, headLength / 2));
-    mark.lineTo(this->mapValueToHand(this->defaultValue_, headLength));
-    ctx.strokePath(mark, this->handStrokeType_);
+
+    auto& layer = this->staticLayers_[size_t(this->isMouseEntered_)];
+    layer.draw(ctx, *this, false, 0, [&](juce::Graphics& g) {
+      g.setOrigin(center);
+
+      // Arc.
+      juce::Colour activeColor = this->isMouseEntered_ ? this->pal_.template getColor<style>()
+                                                       : this->pal_.border().withAlpha(0.3f);
+      g.setColour(activeColor);
+      const auto rHalf = radius / 2;
+      juce::Path arc;
+      arc.addEllipse(-rHalf, -rHalf, rHalf, rHalf);
+      g.strokePath(arc, this->arcStrokeType_);
+
+      // Mark for default value. Sharing color and style with hand.
+      juce::Path mark;
+      mark.startNewSubPath(this->mapValueToHand(this->defaultValue_, headLength / 2));
+      mark.lineTo(this->mapValueToHand(this->defaultValue_, headLength));
+      g.strokePath(mark, this->handStrokeType_);
+    });
+
+    ctx.setOrigin(center);
 
     // Line from center to head.
     const auto headPoint = this->mapValueToHand(this->value_, headLength);
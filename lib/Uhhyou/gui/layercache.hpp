@@ -0,0 +1,54 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <juce_graphics/juce_graphics.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <algorithm>
+
+namespace Uhhyou {
+
+/**
+Image cache of a static layer of a widget, like an arc of knob or a grid of pad. Only the moving
+parts are drawn on top of it on each `paint`.
+
+The image is rendered in physical pixel. It's rebuilt when the size, display scale, or `key`
+changes, or after `invalidate`. Owner should call `invalidate` in `resized` and
+`lookAndFeelChanged`. The latter is called from `EditorBase` on palette change.
+*/
+class LayerCache {
+private:
+  juce::Image image_;
+  int key_ = 0;
+
+public:
+  void invalidate() { image_ = {}; }
+
+  // `paintLayer(juce::Graphics&)` draws in the local coordinate of `component`. Set `isOpaque` when
+  // the layer fills the whole bounds.
+  template<typename PaintFn>
+  void draw(juce::Graphics& ctx, juce::Component& component, bool isOpaque, int key,
+            PaintFn&& paintLayer) {
+    if (component.getWidth() <= 0 || component.getHeight() <= 0) { return; }
+
+    const float scale = juce::Component::getApproximateScaleFactorForComponent(&component);
+    const int width = std::max(1, juce::roundToInt(scale * float(component.getWidth())));
+    const int height = std::max(1, juce::roundToInt(scale * float(component.getHeight())));
+    const bool isStale = !image_.isValid() || key != key_ || image_.getWidth() != width
+      || image_.getHeight() != height;
+    if (isStale) {
+      image_ = juce::Image(isOpaque ? juce::Image::RGB : juce::Image::ARGB, width, height,
+                           !isOpaque);
+      juce::Graphics g(image_);
+      g.addTransform(juce::AffineTransform::scale(float(width) / float(component.getWidth()),
+                                                  float(height) / float(component.getHeight())));
+      paintLayer(g);
+      key_ = key;
+    }
+    ctx.drawImage(image_, component.getLocalBounds().toFloat());
+  }
+};
+
+} // namespace Uhhyou
@@ -0,0 +1,83 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "../dsp/loadmeter.hpp"
+#include "button.hpp"
+#include "numbereditor.hpp"
+#include "style.hpp"
+
+#include <format>
+#include <functional>
+#include <string>
+
+namespace Uhhyou {
+
+// Shows average and peak of `LoadMeter` in percent of block duration. Click to reset. Memory
+// footprint is also shown on status bar if the getter is set.
+class LoadMeterButton : public ActionButton<>, private juce::Timer {
+private:
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoadMeterButton)
+
+  LoadMeter& meter_;
+  LoadMeter::Snapshot snapshot_;
+  std::function<size_t()> getMemoryFootprint_;
+
+  void updateStatusBar() {
+    std::string text = snapshot_.count == 0
+      ? std::string("DSP Load: No block is processed since reset.")
+      : std::format("DSP Load: Average {:.1f}%, 99th percentile {:.1f}%, peak {:.1f}% of block "
+                    "duration in {} blocks. Click to reset.",
+                    100 * snapshot_.average, 100 * snapshot_.percentile99, 100 * snapshot_.peak,
+                    snapshot_.count);
+    if (getMemoryFootprint_) {
+      text += std::format(" Memory: {:.1f} KiB.", double(getMemoryFootprint_()) / 1024);
+    }
+    statusBar_.setText(text);
+  }
+
+  void timerCallback() override {
+    snapshot_ = meter_.getSnapshot();
+
+    juce::String text = snapshot_.count == 0
+      ? juce::String("DSP Load")
+      : juce::String(
+          std::format("{:.1f}% / {:.1f}%", 100 * snapshot_.average, 100 * snapshot_.peak));
+    if (label_ != text) {
+      label_ = text;
+      repaint();
+    }
+    if (isMouseEntered_) { updateStatusBar(); }
+  }
+
+public:
+  LoadMeterButton(juce::AudioProcessorEditor& editor, Palette& palette, StatusBar& statusBar,
+                  NumberEditor& numberEditor, LoadMeter& meter)
+      : ActionButton<>(editor, palette, statusBar, numberEditor, "DSP Load", "",
+                       [this]() {
+                         meter_.requestReset();
+                         snapshot_ = {};
+                         label_ = "DSP Load";
+                         repaint();
+                       }),
+        meter_(meter) {
+    startTimerHz(4);
+  }
+
+  ~LoadMeterButton() override { stopTimer(); }
+
+  void setMemoryFootprintGetter(std::function<size_t()> getter) {
+    getMemoryFootprint_ = std::move(getter);
+  }
+
+  void mouseEnter(const juce::MouseEvent& event) override {
+    ActionButton<>::mouseEnter(event);
+    updateStatusBar();
+  }
+};
+
+} // namespace Uhhyou
@@ -215,29 +215,45 @@ public:
 
   ~FocusRingOverlay() override { juce::Desktop::getInstance().removeFocusChangeListener(this); }
 
+  // This overlay covers the whole editor, so only the old and new ring are repainted.
   void globalFocusChanged(juce::Component*) override {
     if (getParentComponent() != nullptr) { toFront(false); }
-    repaint();
+
+    const auto ringBounds = getRingBounds();
+    const auto area = ringBounds.isEmpty() ? juce::Rectangle<int>{}
+                                           : ringBounds.getSmallestIntegerContainer().expanded(1);
+    if (area == ringArea_) { return; }
+    repaint(ringArea_);
+    repaint(area);
+    ringArea_ = area;
   }
 
   void paint(juce::Graphics& ctx) override {
-    auto* focused = juce::Component::getCurrentlyFocusedComponent();
-    if (!focused) { return; }
+    const auto ringBounds = getRingBounds();
+    if (ringBounds.isEmpty()) { return; }
 
-    auto* parent = getParentComponent();
-    if (!parent) { return; }
-
-    if (focused != parent && parent->isParentOf(focused)) {
-      auto bounds = getLocalArea(focused, focused->getLocalBounds()).toFloat();
-      float thickness = pal_.borderWidth() * float(3);
-      auto ringBounds = bounds.expanded(thickness);
-      ctx.setColour(pal_.getForeground(pal_.background()).withAlpha(float(0.5)));
-      ctx.drawRect(ringBounds, thickness);
-    }
+    float thickness = pal_.borderWidth() * float(3);
+    ctx.setColour(pal_.getForeground(pal_.background()).withAlpha(float(0.5)));
+    ctx.drawRect(ringBounds, thickness);
   }
 
 private:
   Palette& pal_;
+  juce::Rectangle<int> ringArea_;
+
+  juce::Rectangle<float> getRingBounds() {
+    auto* focused = juce::Component::getCurrentlyFocusedComponent();
+    if (!focused) { return {}; }
+
+    auto* parent = getParentComponent();
+    if (!parent) { return {}; }
+
+    if (focused == parent || !parent->isParentOf(focused)) { return {}; }
+
+    auto bounds = getLocalArea(focused, focused->getLocalBounds()).toFloat();
+    float thickness = pal_.borderWidth() * float(3);
+    return bounds.expanded(thickness);
+  }
 };
 
 } // namespace Uhhyou
@@ -8,6 +8,8 @@
 #include <juce_graphics/juce_graphics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include "animationscheduler.hpp"
+
 #include <array>
 #include <atomic>
 #include <functional>
@@ -27,16 +29,22 @@ something like `RangedAudioParameterGroup` is added to JUCE.
 Advantage of using APPG is easier parameter ID management. Only a group ID is required,
 instead of all parameter IDs in a group. Also template can be omitted. Disadvantage is
 dynamic allocation.
+
+Changes from other than message thread are delivered on vblank, in the same way as
+`BatchedParameterAttachment`.
 */
 template<size_t nParameter>
-class ParameterArrayAttachment : private juce::AudioProcessorParameter::Listener,
-                                 private juce::AsyncUpdater {
+class ParameterArrayAttachment : private juce::AudioProcessorParameter::Listener {
 public:
-  ParameterArrayAttachment(std::array<juce::RangedAudioParameter*, nParameter> parameter,
+  ParameterArrayAttachment(juce::Component& host,
+                           std::array<juce::RangedAudioParameter*, nParameter> parameter,
                            std::function<void(int, float)> parameterChangedCallback,
                            juce::UndoManager* undoManager = nullptr)
       : parameter_(parameter), undoManager_(undoManager),
-        parameterChangedCallback_(std::move(parameterChangedCallback)) {
+        parameterChangedCallback_(std::move(parameterChangedCallback)),
+        source_(host, [this]() {
+          if (isPending_.exchange(false, std::memory_order_acquire)) { handleUpdate(); }
+        }) {
     isEditing_.fill(false);
 
     for (auto& x : parameter_) { x->addListener(this); }
@@ -48,7 +56,6 @@ public:
 
   virtual ~ParameterArrayAttachment() override {
     for (auto& x : parameter_) { x->removeListener(this); }
-    cancelPendingUpdate();
   }
 
   void sendInitialUpdate() {
@@ -134,16 +141,15 @@ private:
     lastValue_[index] = newValue;
 
     if (juce::MessageManager::getInstance()->isThisTheMessageThread()) {
-      cancelPendingUpdate();
-      handleAsyncUpdate(static_cast<int>(index));
+      handleUpdate(static_cast<int>(index));
     } else {
-      triggerAsyncUpdate();
+      isPending_.store(true, std::memory_order_release);
     }
   }
 
   void parameterGestureChanged(int, bool) override {}
 
-  void handleAsyncUpdate() override {
+  void handleUpdate() {
     if (parameterChangedCallback_ != nullptr) {
       for (size_t i = 0; i < nParameter; ++i) {
         parameterChangedCallback_(static_cast<int>(i),
@@ -152,7 +158,7 @@ private:
     }
   }
 
-  void handleAsyncUpdate(int index) {
+  void handleUpdate(int index) {
     if (parameterChangedCallback_ != nullptr) {
       auto idx = static_cast<size_t>(index);
       parameterChangedCallback_(index, parameter_[idx]->convertFrom0to1(lastValue_[idx]));
@@ -168,6 +174,8 @@ private:
   std::array<std::atomic<float>, nParameter> lastValue_{};
   juce::UndoManager* undoManager_ = nullptr;
   std::function<void(int, float)> parameterChangedCallback_;
+  std::atomic<bool> isPending_{false};
+  AnimationSource source_;
 
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterArrayAttachment)
 };
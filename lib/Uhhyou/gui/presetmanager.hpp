@@ -51,17 +51,49 @@ private:
   juce::File currentPresetFile_;
   std::vector<juce::File> presetCache_;
 
-  bool isMouseEntered_ = false;
-  juce::Point<int> mousePosition_;
+  enum class Region { none, previous, next, text };
+  Region hoveredRegion_ = Region::none;
 
   juce::Rectangle<int> previousButtonRegion_;
   juce::Rectangle<int> nextButtonRegion_;
   juce::Rectangle<int> textRegion_;
 
-  void updateStatusBar(juce::Point<int> position) {
-    if (previousButtonRegion_.contains(position)) {
+  Region getRegion(juce::Point<int> position) {
+    if (previousButtonRegion_.contains(position)) { return Region::previous; }
+    if (nextButtonRegion_.contains(position)) { return Region::next; }
+    if (textRegion_.contains(position)) { return Region::text; }
+    return Region::none;
+  }
+
+  juce::Rectangle<int> getRegionBounds(Region region) {
+    switch (region) {
+      case Region::previous:
+        return previousButtonRegion_;
+      case Region::next:
+        return nextButtonRegion_;
+      case Region::text:
+        return textRegion_;
+      default:
+        return {};
+    }
+  }
+
+  // Only the regions where the highlight is moved are repainted. `mouseMove` is called on every
+  // mouse movement, but the look only changes when the cursor crosses a region. Returns `true` when
+  // the region is changed.
+  bool setHoveredRegion(Region region) {
+    if (hoveredRegion_ == region) { return false; }
+    repaint(getRegionBounds(hoveredRegion_));
+    repaint(getRegionBounds(region));
+    hoveredRegion_ = region;
+    updateStatusBar();
+    return true;
+  }
+
+  void updateStatusBar() {
+    if (hoveredRegion_ == Region::previous) {
       statusBar_.setText("Previous preset");
-    } else if (nextButtonRegion_.contains(position)) {
+    } else if (hoveredRegion_ == Region::next) {
       statusBar_.setText("Next preset");
     } else {
       statusBar_.setText("Preset menu");
@@ -261,20 +293,14 @@ public:
     ctx.fillRoundedRectangle(bounds, corner);
 
     // Track specific hover states
-    bool prevHovered = isMouseEntered_ && previousButtonRegion_.contains(mousePosition_);
-    bool nextHovered = isMouseEntered_ && nextButtonRegion_.contains(mousePosition_);
-    bool textHovered = isMouseEntered_ && textRegion_.contains(mousePosition_);
+    bool prevHovered = hoveredRegion_ == Region::previous;
+    bool nextHovered = hoveredRegion_ == Region::next;
+    bool textHovered = hoveredRegion_ == Region::text;
 
     // Highlight
-    if (isMouseEntered_) {
+    if (hoveredRegion_ != Region::none) {
       ctx.setColour(pal_.main());
-      if (prevHovered) {
-        ctx.fillRoundedRectangle(previousButtonRegion_.toFloat(), corner);
-      } else if (nextHovered) {
-        ctx.fillRoundedRectangle(nextButtonRegion_.toFloat(), corner);
-      } else if (textHovered) {
-        ctx.fillRoundedRectangle(textRegion_.toFloat(), corner);
-      }
+      ctx.fillRoundedRectangle(getRegionBounds(hoveredRegion_).toFloat(), corner);
     }
 
     ctx.setColour(pal_.border());
@@ -330,20 +356,16 @@ public:
   }
 
   void mouseMove(const juce::MouseEvent& event) override {
-    mousePosition_ = event.getPosition();
-    updateStatusBar(mousePosition_);
-    repaint();
+    setHoveredRegion(getRegion(event.getPosition()));
   }
 
   void mouseEnter(const juce::MouseEvent& event) override {
-    isMouseEntered_ = true;
-    updateStatusBar(event.getPosition());
-    repaint();
+    // Status bar may show text of other widget, even when the region is the same as before.
+    if (!setHoveredRegion(getRegion(event.getPosition()))) { updateStatusBar(); }
   }
   void mouseExit(const juce::MouseEvent&) override {
-    isMouseEntered_ = false;
+    setHoveredRegion(Region::none);
     statusBar_.clear();
-    repaint();
   }
 
   bool keyPressed(const juce::KeyPress& key) override {
@@ -21,6 +21,7 @@
 #include "filemenu.hpp"
 #include "horizontaldrawer.hpp"
 #include "knob.hpp"
+#include "loadmeterbutton.hpp"
 #include "lookandfeel.hpp"
 #include "navigation.hpp"
 #include "popupview.hpp"
@@ -7,6 +7,7 @@
 #include <juce_graphics/juce_graphics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include "layercache.hpp"
 #include "numbereditor.hpp"
 #include "parameterarrayattachment.hpp"
 #include "parameterlock.hpp"
@@ -93,6 +94,8 @@ private:
   bool isEditing_ = false;
   size_t lastActiveAxis_ = 0; // Tracks whether X (0) or Y (1) was last updated
 
+  LayerCache staticLayer_; // Background and grid.
+
   std::array<std::vector<float>, 2> snaps_;
   std::array<bool, 2> isSnapping_{false, false};
   std::array<float, 2> snapDiffAccumulator_{float(0), float(0)};
@@ -258,7 +261,7 @@ public:
         std::array<juce::RangedAudioParameter*, 2> parameters, StatusBar& statusBar)
       : editor_(editor), parameter_(parameters), pal_(palette), statusBar_(statusBar),
         attachment_(
-          parameters,
+          *this, parameters,
           [&](int index, float rawValue) {
             if (index < 0 || index >= 2) { return; }
             size_t idx = static_cast<size_t>(index);
@@ -307,25 +310,31 @@ public:
 
   void setSnapDistance(float pixels) { snapDistancePixel_ = pixels; }
 
+  void resized() override { staticLayer_.invalidate(); }
+
+  void lookAndFeelChanged() override { staticLayer_.invalidate(); }
+
   void paint(juce::Graphics& ctx) override {
     const float width = static_cast<float>(getWidth());
     const float height = static_cast<float>(getHeight());
-
-    // Background.
     juce::Colour bgColour = pal_.surface();
-    ctx.setColour(bgColour);
-    ctx.fillAll();
-
-    // Grid.
-    const float dotRadius = 2 * pal_.borderWidth();
-    ctx.setColour(pal_.getForeground(bgColour).withAlpha(0.5f));
-    for (size_t ix = 1; ix < nGrid; ++ix) {
-      for (size_t iy = 1; iy < nGrid; ++iy) {
-        auto cx = std::floor(static_cast<float>(ix) * width / nGrid);
-        auto cy = std::floor(static_cast<float>(iy) * height / nGrid);
-        ctx.fillEllipse(cx - dotRadius, cy - dotRadius, dotRadius * 2, dotRadius * 2);
+
+    staticLayer_.draw(ctx, *this, true, 0, [&](juce::Graphics& g) {
+      // Background.
+      g.setColour(bgColour);
+      g.fillAll();
+
+      // Grid.
+      const float dotRadius = 2 * pal_.borderWidth();
+      g.setColour(pal_.getForeground(bgColour).withAlpha(0.5f));
+      for (size_t ix = 1; ix < nGrid; ++ix) {
+        for (size_t iy = 1; iy < nGrid; ++iy) {
+          auto cx = std::floor(static_cast<float>(ix) * width / nGrid);
+          auto cy = std::floor(static_cast<float>(iy) * height / nGrid);
+          g.fillEllipse(cx - dotRadius, cy - dotRadius, dotRadius * 2, dotRadius * 2);
+        }
       }
-    }
+    });
 
     // Mouse Cursor Crosshair.
     if (isMouseEntered_) {
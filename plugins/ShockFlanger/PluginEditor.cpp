@@ -65,6 +65,8 @@ const juce::String sToggles{"Toggles"};
 Editor::Editor(Processor& proc) : EditorBase(proc, informationText) {
   auto& sc = proc.param.scale;
 
+  val().displayTelemetry.clear(); // Records queued while the editor was closed are stale.
+
   auto snapsToNormalized = [&](const auto& source, auto converter) {
     std::vector<float> keys;
     keys.reserve(source.size());
@@ -182,6 +184,15 @@ Editor::Editor(Processor& proc) : EditorBase(proc, informationText) {
 
 void Editor::paint(juce::Graphics& ctx) { EditorBase::paint(ctx); }
 
+void Editor::drainTelemetry() {
+  val().displayTelemetry.drain([&](const DisplayRecord& record) {
+    lfoPhaseDisplay_.push(record.lfoPhase);
+    delayTimeDisplay_.push(record);
+    meterPreSaturationPeak_.push(record.preSaturationPeak);
+    meterOutputPeak_.push(record.outputPeak);
+  });
+}
+
 void Editor::resized() {
   EditorBase<Processor>::resized();
 
@@ -220,7 +231,8 @@ void Editor::resized() {
   meterOutputPeak_.setBounds(Rect{left0 + mt.labelX, meterTop, mt.labelW, meterH});
 
   const int statusTop = meterTop + meterH + 2 * mt.margin;
-  statusBar_.setBounds(Rect{left0, statusTop, mt.totalWidth - left0 - mt.uiMargin, mt.labelH});
+  layoutStatusBar(Rect{left0, statusTop, mt.totalWidth - left0 - mt.uiMargin, mt.labelH},
+                  mt.margin, mt.labelW);
 
   auto addSection = [&](int& top, int left, const juce::String& sectionTitle) {
     if (auto sc = sections_.find(sectionTitle); sc != sections_.end()) {
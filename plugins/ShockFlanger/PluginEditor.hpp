@@ -27,11 +27,13 @@ public:
 
 private:
   decltype(processor_.param.value)& val() { return processor_.param.value; }
+  void drainTelemetry();
 
-  LfoPhaseDisplay lfoPhaseDisplay_{*this, palette_, val().displayLfoPhase};
-  DelayTimeDisplay delayTimeDisplay_{*this, palette_, val()};
-  MeterDisplay meterPreSaturationPeak_{*this, palette_, val().displayPreSaturationPeak, "Pre-Sat."};
-  MeterDisplay meterOutputPeak_{*this, palette_, val().displayOutputPeak, "Output"};
+  LfoPhaseDisplay lfoPhaseDisplay_{*this, palette_};
+  DelayTimeDisplay delayTimeDisplay_{*this, palette_};
+  MeterDisplay meterPreSaturationPeak_{*this, palette_, "Pre-Sat."};
+  MeterDisplay meterOutputPeak_{*this, palette_, "Output"};
+  AnimationSource telemetrySource_{*this, [this]() { drainTelemetry(); }};
   HorizontalDrawer drawer_{palette_, statusBar_, "XY Pads", true};
 };
 
@@ -262,31 +262,20 @@ void DSPCore::process(const size_t length, const float* in0, const float* in1, f
   }
 
   // Send values to GUI.
-  constexpr auto mem = std::memory_order_relaxed;
-  auto& pv = param.value;
-
-  auto storeMax = [&](std::atomic<float>& target, Real value) {
-    float candidate = float(value);
-    float current = target.load(mem);
-    if (current < candidate) { target.store(candidate, mem); }
-  };
-
-  storeMax(pv.displayPreSaturationPeak[0], preSaturationPeak_[0]);
-  storeMax(pv.displayPreSaturationPeak[1], preSaturationPeak_[1]);
-  storeMax(pv.displayOutputPeak[0], outputPeak_[0]);
-  storeMax(pv.displayOutputPeak[1], outputPeak_[1]);
-  pv.displayLfoPhase[0].store(float(modPhase_[0]), mem);
-  pv.displayLfoPhase[1].store(float(modPhase_[1]), mem);
+  if (length == 0) { return; }
 
+  DisplayRecord record;
   const Real invUpRate = Real(1) / upRate_;
-  for (size_t ch = 0; ch < 2; ++ch) {
+  for (size_t ch = 0; ch < nChannel; ++ch) {
+    record.preSaturationPeak[ch] = float(preSaturationPeak_[ch]);
+    record.outputPeak[ch] = float(outputPeak_[ch]);
+    record.lfoPhase[ch] = float(modPhase_[ch]);
     for (size_t i = 0; i < 2; ++i) {
-      pv.displayDelayTimeUpper[ch][i].store(
-        static_cast<float>(displayTime_[ch].upper[i] * invUpRate), mem);
-      pv.displayDelayTimeLower[ch][i].store(
-        static_cast<float>(displayTime_[ch].lower[i] * invUpRate), mem);
+      record.delayTimeUpper[ch][i] = float(displayTime_[ch].upper[i] * invUpRate);
+      record.delayTimeLower[ch][i] = float(displayTime_[ch].lower[i] * invUpRate);
     }
   }
+  param.value.displayTelemetry.push(record);
 }
 
 template<typename Real> inline Real semitoneToRatio(Real scaler, Real semitone) {
@@ -296,6 +285,9 @@ template<typename Real> inline Real semitoneToRatio(Real scaler, Real semitone)
 void DSPCore::noteOn(int noteId, Real pitchSemitone, Real velocity) {
   if (!noteReceive_) { return; }
 
+  // Oldest note is dropped to avoid allocation on audio thread. This only happens when a host sends
+  // note-on without note-off.
+  if (noteIdStack_.size() >= maxNote) { noteIdStack_.erase(noteIdStack_.begin()); }
   noteIdStack_.push_back({
     .pitch = semitoneToRatio(notePitchScalar_, pitchSemitone),
     .gain = ScaleTools::dbToAmp(noteGainScalar_ * Real(velocity)),
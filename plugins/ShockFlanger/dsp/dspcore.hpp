@@ -18,7 +18,7 @@ class DSPCore {
 public:
   using Real = double;
 
-  DSPCore(ParameterStore& p) : param(p) { noteIdStack_.reserve(1024); }
+  DSPCore(ParameterStore& p) : param(p) { noteIdStack_.reserve(maxNote); }
 
   ParameterStore& param;
   Real tempo = Real(120);
@@ -45,6 +45,7 @@ private:
   std::array<Real, 2> processSample(const std::array<Real, 2> in);
 
   static constexpr unsigned upFold = 2;
+  static constexpr size_t maxNote = 16 * 128; // All note numbers on all MIDI channels.
   static constexpr Real smootherTimeInSecond = Real(0.2);
 
   struct NoteData {
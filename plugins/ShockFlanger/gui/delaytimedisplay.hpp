@@ -8,100 +8,156 @@
 #include <juce_gui_extra/juce_gui_extra.h>
 
 #include "../parameter.hpp"
+#include "Uhhyou/gui/animationscheduler.hpp"
 #include "Uhhyou/gui/style.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <deque>
 #include <format>
 #include <limits>
 #include <numbers>
+#include <vector>
 
 namespace Uhhyou {
 
-class DelayTimeDisplay : public juce::AnimatedAppComponent {
+class DelayTimeDisplay : public AnimatedComponent {
 private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayTimeDisplay)
 
   static constexpr float historyMs = float(2000);
   static constexpr float fadeDurationMs = float(500);
+  static constexpr size_t nLane = 2 * nChannel;
+
+  // Horizontal axis is 0.1 to 10000 ms in log scale.
+  static constexpr std::array<float, 6> tickMs{
+    float(0.1), float(1), float(10), float(100), float(1000), float(10000),
+  };
+  static constexpr float minLog10 = float(-1);
+  static constexpr float maxLog10 = float(4);
+  static constexpr float logRange = maxLog10 - minLog10;
+
+  // `update` is at least 1 ms apart, so this covers `historyMs`. Must be a power of 2.
+  static constexpr size_t traceCapacity = 2048;
 
   Palette& pal_;
-  ValueReceivers& pv_;
 
+  // Range of delay time since last `update`. `[Channel][Lane]`. Initial value is the left end of
+  // the axis, which is inside the limits, so that no warning is shown before the first record.
+  static constexpr float initialSecond = float(0.0001);
+  std::array<std::array<float, 2>, nChannel> pendingUpper_ = makeInitialPending();
+  std::array<std::array<float, 2>, nChannel> pendingLower_ = makeInitialPending();
+  bool hasPending_ = false;
+
+  static constexpr std::array<std::array<float, 2>, nChannel> makeInitialPending() {
+    std::array<std::array<float, 2>, nChannel> pending{};
+    for (auto& lane : pending) { lane.fill(initialSecond); }
+    return pending;
+  }
+
+  // `lower` and `upper` are normalized positions on horizontal axis in [0, 1]. `log10` is computed
+  // once when pushed, instead of every `paint` on all the points.
   struct TracePoint {
-    float value;
-    float ms; // Time duration this sample represents.
+    float lower = float(1);
+    float upper = float(0);
+    float ms = float(0); // Time duration this sample represents.
   };
 
-  using TraceDeque = std::deque<TracePoint>;
-  std::array<std::array<TraceDeque, 2>, nChannel> trailUpper_;
-  std::array<std::array<TraceDeque, 2>, nChannel> trailLower_;
+  // Preallocated ring buffer. The oldest point is overwritten when full.
+  class TraceRing {
+  private:
+    static constexpr size_t mask = traceCapacity - 1;
 
-  // [Channel][Lane][0=Min, 1=Max]
-  std::array<std::array<std::array<float, 2>, 2>, nChannel> limitWarnings_{};
+    std::vector<TracePoint> buffer_ = std::vector<TracePoint>(traceCapacity);
+    size_t head_ = 0;
+    size_t size_ = 0;
 
-public:
-  DelayTimeDisplay(Component& parent, Palette& palette, ValueReceivers& valueReceiver)
-      : pal_(palette), pv_(valueReceiver) {
-    setSynchroniseToVBlank(true);
-    parent.addAndMakeVisible(*this, 0);
-  }
+  public:
+    void push(const TracePoint& point) {
+      buffer_[head_] = point;
+      head_ = (head_ + 1) & mask;
+      size_ = std::min(size_ + 1, traceCapacity);
+    }
 
-  virtual ~DelayTimeDisplay() override {}
+    size_t size() const { return size_; }
 
-  virtual void update() override {
-    // Clamp dt to reasonable bounds to prevent instability.
-    const float dt
-      = std::clamp(static_cast<float>(getMillisecondsSinceLastUpdate()), float(1), float(100));
-    const float decay = dt / fadeDurationMs;
+    // `index = 0` is the newest.
+    const TracePoint& fromNewest(size_t index) const {
+      return buffer_[(head_ + traceCapacity - 1 - index) & mask];
+    }
+  };
 
-    auto updateLane = [&](TraceDeque& trail, const std::atomic<float>& source) {
-      trail.push_back({source.load(std::memory_order_relaxed), dt});
+  std::array<std::array<TraceRing, 2>, nChannel> trace_;
 
-      // Lazy pruning: only check if size gets large.
-      if (trail.size() > 20) {
-        float total = float(0);
-        for (const auto& pt : trail) { total += pt.ms; }
+  // Range of trace since the last row drawn to `traceImage_`. `ms` is unused.
+  std::array<std::array<TracePoint, 2>, nChannel> unscrolled_{};
+  float scrollRemainder_ = float(0); // In pixel.
+  float stillMs_ = float(0); // Trace is flat when this reaches `historyMs`.
 
-        while (total > historyMs && !trail.empty()) {
-          total -= trail.front().ms;
-          trail.pop_front();
-        }
-      }
-    };
+  // [Channel][Lane][0=Min, 1=Max]
+  std::array<std::array<std::array<float, 2>, 2>, nChannel> limitWarnings_{};
 
-    for (size_t i = 0; i < nChannel; ++i) {
-      for (size_t j = 0; j < 2; ++j) {
-        updateLane(trailUpper_[i][j], pv_.displayDelayTimeUpper[i][j]);
-        updateLane(trailLower_[i][j], pv_.displayDelayTimeLower[i][j]);
+  /*
+  `gridImage_` holds background, labels and ticks. `traceImage_` holds the waterfall graph without
+  fading, and it's scrolled up in `update` with only the new rows drawn at the bottom. Both are
+  rendered in physical pixel, and discarded on resize or palette change.
+  */
+  juce::Image gridImage_;
+  juce::Image traceImage_;
+  float imageScale_ = float(1);
+  std::array<float, tickMs.size()> gridX_{};
+
+  struct Layout {
+    juce::Rectangle<float> full;
+    juce::Rectangle<float> header;
+    juce::Rectangle<float> sideLabel;
+    juce::Rectangle<float> graph;
+    float laneHeight;
+  };
 
-        auto& warnings = limitWarnings_[i][j];
+  static float timeToAxis(float seconds) {
+    const auto s = std::max(seconds, float(0.00001));
+    const auto ms = float(1000) * s;
+    const auto normalized = (std::log10(ms) - minLog10) / logRange;
+    return std::clamp(normalized, float(0), float(1));
+  }
 
-        warnings[0] = std::max(float(0), warnings[0] - decay);
-        warnings[1] = std::max(float(0), warnings[1] - decay);
+  Layout getLayout() {
+    const auto& fontSmall = pal_.getFont(TextSize::small);
 
-        if (!trailLower_[i][j].empty()) {
-          if (trailLower_[i][j].back().value <= float(0)) { warnings[0] = float(1); }
-        }
-        if (!trailUpper_[i][j].empty()) {
-          if (trailUpper_[i][j].back().value >= float(10)) { warnings[1] = float(1); }
-        }
-      }
-    }
+    Layout layout;
+    layout.full = getLocalBounds().toFloat();
+    auto remainingBounds = layout.full;
+    layout.header = remainingBounds.removeFromTop(fontSmall.getHeight());
+    layout.sideLabel = remainingBounds.removeFromLeft(3 * fontSmall.getHeight());
+    layout.graph = remainingBounds;
+    layout.laneHeight = layout.graph.getHeight() / float(nLane);
+    return layout;
   }
 
-  virtual void paint(juce::Graphics& ctx) override {
-    const auto fullBounds = getLocalBounds().toFloat();
-    const auto& fontSmall = pal_.getFont(TextSize::small);
-    const float headerHeight = fontSmall.getHeight();
-    const float sideLabelWidth = 3 * fontSmall.getHeight();
+  // Lane boundary in `traceImage_`. `lane` is in [0, nLane].
+  int lanePixel(size_t lane) const {
+    return juce::roundToInt(float(lane * size_t(traceImage_.getHeight())) / float(nLane));
+  }
+
+  float pixelPerMs() const { return float(traceImage_.getHeight()) / (float(nLane) * historyMs); }
+
+  void fillTrace(juce::Graphics& g, const TracePoint& point, float y, float height) {
+    const float width = float(traceImage_.getWidth());
+    const float minTrailWidth = imageScale_ * pal_.borderWidth();
+    const float drawWidth = std::max(minTrailWidth, width * (point.upper - point.lower));
+    g.fillRect(std::floor(width * point.lower), y, drawWidth, height);
+  }
 
-    auto remainingBounds = fullBounds;
-    auto headerBounds = remainingBounds.removeFromTop(headerHeight);
-    auto sideLabelBounds = remainingBounds.removeFromLeft(sideLabelWidth);
-    auto graphBounds = remainingBounds;
+  void renderGrid(const Layout& layout) {
+    gridImage_ = juce::Image(juce::Image::RGB,
+                             std::max(1, juce::roundToInt(imageScale_ * layout.full.getWidth())),
+                             std::max(1, juce::roundToInt(imageScale_ * layout.full.getHeight())),
+                             false);
+    juce::Graphics ctx(gridImage_);
+    ctx.addTransform(juce::AffineTransform::scale(imageScale_));
+
+    const auto& fontSmall = pal_.getFont(TextSize::small);
 
     // Background.
     juce::Colour bgColour = pal_.background();
@@ -109,50 +165,26 @@ public:
     ctx.fillAll();
 
     ctx.setColour(pal_.surface());
-    ctx.fillRect(graphBounds);
-
-    // Grid & Ticks.
-    constexpr std::array<float, 6> tickMs{
-      float(0.1), float(1), float(10), float(100), float(1000), float(10000),
-    };
-    constexpr float minLog10 = float(-1);
-    constexpr float maxLog10 = float(4);
-    constexpr float logRange = maxLog10 - minLog10;
-
-    auto timeToGraphX = [&](float seconds) -> float {
-      const auto s = std::max(seconds, float(0.00001));
-      const auto ms = float(1000) * s;
-      const auto logVal = std::log10(ms);
-      const auto normalized = (logVal - minLog10) / logRange;
-      return graphBounds.getX()
-        + graphBounds.getWidth() * std::clamp(normalized, float(0), float(1));
-    };
+    ctx.fillRect(layout.graph);
 
+    // Ticks.
     ctx.setFont(fontSmall);
     const float margin = float(4) * pal_.borderWidth();
 
     ctx.setColour(pal_.getForeground(bgColour));
     juce::String timeText = "Delay[ms]";
     const float timeLabelW = juce::GlyphArrangement::getStringWidth(fontSmall, timeText);
-    juce::Rectangle<float> timeLabelRect(0, 0, timeLabelW + margin, headerBounds.getHeight());
+    juce::Rectangle<float> timeLabelRect(0, 0, timeLabelW + margin, layout.header.getHeight());
     ctx.drawText(timeText, timeLabelRect.toNearestInt(), juce::Justification::centred, false);
 
-    const float gridLineWidth = std::max(float(1), float(0.125) * pal_.borderWidth());
     for (size_t i = 0; i < tickMs.size(); ++i) {
       float ms = tickMs[i];
-      float x = timeToGraphX(ms / float(1000));
-
-      // Grid line.
-      ctx.setColour(pal_.background().withAlpha(0.25f));
-      ctx.drawVerticalLine(juce::roundToInt(x) - 1, headerBounds.getBottom(),
-                           fullBounds.getBottom());
+      float x = layout.graph.getX() + layout.graph.getWidth() * timeToAxis(ms / float(1000));
+      gridX_[i] = x;
 
-      // Label.
       juce::String labelText = std::format("{}", ms);
       const float textW = juce::GlyphArrangement::getStringWidth(fontSmall, labelText);
-      juce::Rectangle<float> labelRect(0, 0, textW + margin, headerBounds.getHeight());
-
-      ctx.setColour(pal_.getForeground(bgColour));
+      juce::Rectangle<float> labelRect(0, 0, textW + margin, layout.header.getHeight());
 
       if (i == 0) {
       } else if (i == tickMs.size() - 1 || ms >= float(10)) {
@@ -160,85 +192,231 @@ public:
         labelRect.setRight(x - 2 * pal_.borderWidth());
         ctx.drawText(labelText, labelRect.toNearestInt(), juce::Justification::centredRight, false);
       } else {
-        labelRect.setCentre(x, headerBounds.getCentreY());
+        labelRect.setCentre(x, layout.header.getCentreY());
         ctx.drawText(labelText, labelRect.toNearestInt(), juce::Justification::centred, false);
       }
     }
 
     // Side labels.
     std::array<std::array<juce::String, 2>, nChannel> labelNames{{{"L0", "L1"}, {"R0", "R1"}}};
-    const float laneHeight = graphBounds.getHeight() / float(nChannel * 2);
-
-    ctx.setColour(pal_.getForeground(bgColour));
-    auto currentSideBounds = sideLabelBounds;
+    auto currentSideBounds = layout.sideLabel;
     for (size_t i = 0; i < nChannel; ++i) {
       for (size_t j = 0; j < 2; ++j) {
-        auto area = currentSideBounds.removeFromTop(laneHeight);
+        auto area = currentSideBounds.removeFromTop(layout.laneHeight);
         ctx.drawText(labelNames[i][j], area.toNearestInt(), juce::Justification::centred);
       }
     }
+  }
 
-    // Waterfall graph.
-    auto currentGraphBounds = graphBounds;
-    auto minTrailWidth = pal_.borderWidth();
-    auto minReticleWidth = pal_.borderWidth();
+  // Redraws whole history. Newest is at the bottom of each lane.
+  void renderTrace(const Layout& layout) {
+    traceImage_ = juce::Image(juce::Image::RGB,
+                              std::max(1, juce::roundToInt(imageScale_ * layout.graph.getWidth())),
+                              std::max(1, juce::roundToInt(imageScale_ * layout.graph.getHeight())),
+                              false);
+    juce::Graphics g(traceImage_);
+    g.fillAll(pal_.surface());
+    g.setColour(pal_.main());
+
+    const float pxPerMs = pixelPerMs();
+    const float overlap = float(0.5) * imageScale_ * pal_.borderWidth();
     for (size_t i = 0; i < nChannel; ++i) {
       for (size_t j = 0; j < 2; ++j) {
-        auto laneArea = currentGraphBounds.removeFromTop(laneHeight);
+        const size_t lane = 2 * i + j;
+        const int top = lanePixel(lane);
+        const int bottom = lanePixel(lane + 1);
+
+        juce::Graphics::ScopedSaveState stateSaver(g);
+        g.reduceClipRegion(0, top, traceImage_.getWidth(), bottom - top);
+
+        const auto& trace = trace_[i][j];
+        float currentY = float(bottom);
+        for (size_t k = 0; k < trace.size(); ++k) {
+          const auto& point = trace.fromNewest(k);
+          const float yTop = currentY - point.ms * pxPerMs;
+          fillTrace(g, point, yTop, currentY - yTop + overlap);
+          currentY = yTop;
+          if (currentY < float(top)) { break; }
+        }
 
-        ctx.setColour(pal_.background());
-        ctx.drawHorizontalLine(juce::roundToInt(laneArea.getY()), laneArea.getX(),
-                               fullBounds.getRight());
+        unscrolled_[i][j] = {};
+      }
+    }
+    scrollRemainder_ = float(0);
+  }
 
-        juce::Graphics::ScopedSaveState stateSaver(ctx);
-        ctx.reduceClipRegion(laneArea.toNearestInt());
+  // Scrolls up by whole pixels, and draws only the new rows.
+  void scrollTrace(float dt) {
+    if (!traceImage_.isValid()) { return; }
+
+    scrollRemainder_ += dt * pixelPerMs();
+    const int shift = static_cast<int>(scrollRemainder_);
+    if (shift <= 0) { return; }
+    scrollRemainder_ -= float(shift);
+
+    const int width = traceImage_.getWidth();
+    for (size_t lane = 0; lane < nLane; ++lane) {
+      const int top = lanePixel(lane);
+      const int height = lanePixel(lane + 1) - top;
+      if (shift < height) {
+        traceImage_.moveImageSection(0, top, 0, top + shift, width, height - shift);
+      }
+    }
 
-        const auto& tLower = trailLower_[i][j];
-        const auto& tUpper = trailUpper_[i][j];
+    juce::Graphics g(traceImage_);
+    for (size_t i = 0; i < nChannel; ++i) {
+      for (size_t j = 0; j < 2; ++j) {
+        const size_t lane = 2 * i + j;
+        const int bottom = lanePixel(lane + 1);
+        const int rows = std::min(shift, bottom - lanePixel(lane));
+
+        juce::Graphics::ScopedSaveState stateSaver(g);
+        g.reduceClipRegion(0, bottom - rows, width, rows);
+        g.fillAll(pal_.surface());
+        g.setColour(pal_.main());
+        fillTrace(g, unscrolled_[i][j], float(bottom - rows), float(rows));
+        unscrolled_[i][j] = {};
+      }
+    }
+  }
 
-        float currentY = laneArea.getBottom();
-        float accumMs = float(0);
+public:
+  DelayTimeDisplay(Component& parent, Palette& palette) : pal_(palette) {
+    parent.addAndMakeVisible(*this, 0);
+  }
 
-        // Draw from Bottom (Newest) to Top (Oldest)
-        size_t count = std::min(tLower.size(), tUpper.size());
+  virtual ~DelayTimeDisplay() override {}
 
-        for (size_t k = 0; k < count; ++k) {
-          size_t idx = count - 1 - k;
-          const auto& ptL = tLower[idx];
-          const auto& ptR = tUpper[idx];
+  void push(const DisplayRecord& record) {
+    for (size_t i = 0; i < nChannel; ++i) {
+      for (size_t j = 0; j < 2; ++j) {
+        const auto upper = record.delayTimeUpper[i][j];
+        const auto lower = record.delayTimeLower[i][j];
+        pendingUpper_[i][j] = hasPending_ ? std::max(pendingUpper_[i][j], upper) : upper;
+        pendingLower_[i][j] = hasPending_ ? std::min(pendingLower_[i][j], lower) : lower;
+      }
+    }
+    hasPending_ = true;
+  }
 
-          float segmentHeight = (ptL.ms / historyMs) * laneArea.getHeight();
-          float yBottom = currentY;
-          float yTop = yBottom - segmentHeight;
+  virtual void resized() override {
+    gridImage_ = {};
+    traceImage_ = {};
+  }
 
-          float screenX1 = timeToGraphX(ptL.value);
-          float screenX2 = timeToGraphX(ptR.value);
+  // Called on palette change from `EditorBase`.
+  virtual void lookAndFeelChanged() override {
+    gridImage_ = {};
+    traceImage_ = {};
+  }
 
-          float rawWidth = screenX2 - screenX1;
-          float drawWidth = std::max(minTrailWidth, rawWidth);
+  virtual bool advance(int elapsedMs) override {
+    // Clamp dt to reasonable bounds to prevent instability.
+    const float dt = std::clamp(static_cast<float>(elapsedMs), float(1), float(100));
+    const float decay = dt / fadeDurationMs;
 
-          float progress = accumMs / historyMs;
-          float alpha = std::clamp(float(1) - progress * progress, float(0), float(1));
+    bool isMoved = false;
+    bool isWarning = false;
 
-          ctx.setColour(pal_.main().withAlpha(alpha));
-          ctx.fillRect(std::floor(screenX1), yTop, drawWidth,
-                       yBottom - yTop + float(0.5) * minTrailWidth);
+    // Last value is held when no block is processed since last frame.
+    for (size_t i = 0; i < nChannel; ++i) {
+      for (size_t j = 0; j < 2; ++j) {
+        const TracePoint point{
+          timeToAxis(pendingLower_[i][j]), timeToAxis(pendingUpper_[i][j]), dt};
+        auto& trace = trace_[i][j];
+        isMoved |= trace.size() == 0 || trace.fromNewest(0).lower != point.lower
+          || trace.fromNewest(0).upper != point.upper;
+        trace.push(point);
 
-          currentY = yTop;
-          accumMs += ptL.ms;
+        auto& span = unscrolled_[i][j];
+        span.lower = std::min(span.lower, point.lower);
+        span.upper = std::max(span.upper, point.upper);
 
-          if (currentY < laneArea.getY()) { break; }
-        }
+        auto& warnings = limitWarnings_[i][j];
 
-        // Current value reticle.
-        if (!tLower.empty()) {
-          float curL = tLower.back().value;
-          float curR = tUpper.back().value;
+        warnings[0] = std::max(float(0), warnings[0] - decay);
+        warnings[1] = std::max(float(0), warnings[1] - decay);
+
+        // Only new records raise warnings. Otherwise, a held value at the limit keeps the display
+        // animating while the processor is stopped.
+        if (hasPending_ && pendingLower_[i][j] <= float(0)) { warnings[0] = float(1); }
+        if (hasPending_ && pendingUpper_[i][j] >= float(10)) { warnings[1] = float(1); }
+        isWarning |= warnings[0] > float(0) || warnings[1] > float(0);
+      }
+    }
+    hasPending_ = false;
+
+    scrollTrace(dt);
+
+    stillMs_ = isMoved ? float(0) : std::min(stillMs_ + dt, historyMs);
+    return stillMs_ < historyMs || isWarning;
+  }
+
+  virtual void paintFrame(juce::Graphics& ctx) override {
+    const auto layout = getLayout();
+    const auto& graphBounds = layout.graph;
+
+    const float scale = juce::Component::getApproximateScaleFactorForComponent(this);
+    if (scale != imageScale_) {
+      imageScale_ = scale;
+      gridImage_ = {};
+      traceImage_ = {};
+    }
+    if (!gridImage_.isValid()) { renderGrid(layout); }
+    if (!traceImage_.isValid()) { renderTrace(layout); }
+
+    ctx.drawImage(gridImage_, layout.full);
+    ctx.drawImage(traceImage_, graphBounds);
+
+    juce::Colour bgColour = pal_.background();
+    const float gridLineWidth = std::max(float(1), float(0.125) * pal_.borderWidth());
+
+    // Fading. Overlaying surface color with alpha `progress^2` is the same as drawing the trace
+    // with alpha `1 - progress^2`. Progress is linear in y, so the curve is approximated by stops.
+    constexpr size_t nFadeStop = 8;
+    const auto surface = pal_.surface();
+    auto currentGraphBounds = graphBounds;
+    for (size_t lane = 0; lane < nLane; ++lane) {
+      auto laneArea = currentGraphBounds.removeFromTop(layout.laneHeight);
+      juce::ColourGradient fade(surface.withAlpha(float(0)), laneArea.getX(),
+                                laneArea.getBottom(), surface, laneArea.getX(), laneArea.getY(),
+                                false);
+      for (size_t k = 1; k < nFadeStop; ++k) {
+        const float progress = float(k) / float(nFadeStop);
+        fade.addColour(progress, surface.withAlpha(progress * progress));
+      }
+      ctx.setGradientFill(fade);
+      ctx.fillRect(laneArea);
+    }
 
-          float sx1 = timeToGraphX(curL);
-          float sx2 = timeToGraphX(curR);
+    // Grid.
+    ctx.setColour(bgColour.withAlpha(0.25f));
+    for (const auto& x : gridX_) {
+      ctx.drawVerticalLine(juce::roundToInt(x) - 1, layout.header.getBottom(),
+                           layout.full.getBottom());
+    }
+
+    currentGraphBounds = graphBounds;
+    auto minTrailWidth = pal_.borderWidth();
+    auto minReticleWidth = pal_.borderWidth();
+    for (size_t i = 0; i < nChannel; ++i) {
+      for (size_t j = 0; j < 2; ++j) {
+        auto laneArea = currentGraphBounds.removeFromTop(layout.laneHeight);
+
+        ctx.setColour(pal_.background());
+        ctx.drawHorizontalLine(juce::roundToInt(laneArea.getY()), laneArea.getX(),
+                               layout.full.getRight());
+
+        juce::Graphics::ScopedSaveState stateSaver(ctx);
+        ctx.reduceClipRegion(laneArea.toNearestInt());
+
+        // Current value reticle.
+        const auto& trace = trace_[i][j];
+        if (trace.size() > 0) {
+          const auto& current = trace.fromNewest(0);
 
-          float rawWidth = sx2 - sx1;
+          float sx1 = laneArea.getX() + laneArea.getWidth() * current.lower;
+          float rawWidth = laneArea.getWidth() * (current.upper - current.lower);
           float trailVisualWidth = std::max(minTrailWidth, rawWidth);
           float reticleWidth = std::max(minReticleWidth, rawWidth);
 
@@ -269,8 +447,8 @@ public:
     }
 
     ctx.setColour(pal_.background());
-    const int bottomLineY = static_cast<int>(fullBounds.getBottom() - float(0.5) * gridLineWidth);
-    ctx.drawHorizontalLine(bottomLineY, currentGraphBounds.getX(), fullBounds.getRight());
+    const int bottomLineY = static_cast<int>(layout.full.getBottom() - float(0.5) * gridLineWidth);
+    ctx.drawHorizontalLine(bottomLineY, currentGraphBounds.getX(), layout.full.getRight());
   }
 };
 
@@ -8,11 +8,11 @@
 #include <juce_gui_extra/juce_gui_extra.h>
 
 #include "../parameter.hpp"
+#include "Uhhyou/gui/animationscheduler.hpp"
 #include "Uhhyou/gui/style.hpp"
 
 #include <algorithm>
 #include <array>
-#include <atomic>
 #include <cmath>
 #include <deque>
 #include <limits>
@@ -20,25 +20,24 @@
 
 namespace Uhhyou {
 
-class LfoPhaseDisplay : public juce::AnimatedAppComponent {
+class LfoPhaseDisplay : public AnimatedComponent {
 private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LfoPhaseDisplay)
 
   static constexpr size_t trailLength = 64; // frames.
 
   Palette& pal_;
-  std::array<std::atomic<float>, nChannel>& phase_;
+  std::array<float, nChannel> phase_{}; // Latest value.
 
   juce::PathStrokeType stroke_;
   std::array<std::deque<float>, nChannel> trails_;
+  size_t settleFrames_ = trailLength; // Trails stop moving when this reaches 0.
 
 public:
-  LfoPhaseDisplay(Component& parent, Palette& palette,
-                  std::array<std::atomic<float>, nChannel>& lfoPhase)
-      : pal_(palette), phase_(lfoPhase),
+  LfoPhaseDisplay(Component& parent, Palette& palette)
+      : pal_(palette),
         stroke_(4 * palette.borderWidth(), juce::PathStrokeType::JointStyle::curved,
                 juce::PathStrokeType::EndCapStyle::rounded) {
-    setSynchroniseToVBlank(true);
     parent.addAndMakeVisible(*this, 0);
 
     for (auto& x : trails_) { x.resize(trailLength, float(0)); }
@@ -48,14 +47,20 @@ public:
 
   virtual void resized() override { stroke_.setStrokeThickness(4 * pal_.borderWidth()); }
 
-  virtual void update() override {
+  void push(const std::array<float, nChannel>& lfoPhase) { phase_ = lfoPhase; }
+
+  virtual bool advance(int) override {
+    bool isMoved = false;
     for (size_t i = 0; i < trails_.size(); ++i) {
-      trails_[i].push_back(phase_[i].load(std::memory_order_relaxed));
+      isMoved |= trails_[i].back() != phase_[i];
+      trails_[i].push_back(phase_[i]);
       trails_[i].pop_front();
     }
+    settleFrames_ = isMoved ? trailLength : settleFrames_ - size_t(settleFrames_ > 0);
+    return settleFrames_ > 0;
   }
 
-  virtual void paint(juce::Graphics& ctx) override {
+  virtual void paintFrame(juce::Graphics& ctx) override {
     constexpr float twopi = float(2) * std::numbers::pi_v<float>;
     constexpr float halfpi = float(0.5) * std::numbers::pi_v<float>;
 
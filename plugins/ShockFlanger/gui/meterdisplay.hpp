@@ -8,24 +8,25 @@
 #include <juce_gui_extra/juce_gui_extra.h>
 
 #include "../parameter.hpp"
+#include "Uhhyou/gui/animationscheduler.hpp"
 #include "Uhhyou/gui/style.hpp"
 
 #include <algorithm>
 #include <array>
-#include <atomic>
 #include <cmath>
 #include <format>
 #include <limits>
 #include <numbers>
+#include <utility>
 
 namespace Uhhyou {
 
-class MeterDisplay : public juce::AnimatedAppComponent {
+class MeterDisplay : public AnimatedComponent {
 private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterDisplay)
 
   Palette& pal_;
-  std::array<std::atomic<float>, nChannel>& peakAmp_;
+  std::array<float, nChannel> peakAmp_{}; // Maximum since last `update`.
 
   struct MeterState {
     float peakN{}; // N: normalized in [0, 1].
@@ -56,12 +57,10 @@ private:
   }
 
 public:
-  MeterDisplay(Component& parent, Palette& palette,
-               std::array<std::atomic<float>, nChannel>& peakAmplitude, const juce::String& label)
-      : pal_(palette), peakAmp_(peakAmplitude), labelTitle_(label),
+  MeterDisplay(Component& parent, Palette& palette, const juce::String& label)
+      : pal_(palette), labelTitle_(label),
         stroke_(palette.borderWidth(), juce::PathStrokeType::JointStyle::curved,
                 juce::PathStrokeType::EndCapStyle::rounded) {
-    setSynchroniseToVBlank(true);
     parent.addAndMakeVisible(*this, 0);
   }
 
@@ -69,14 +68,17 @@ public:
 
   virtual void resized() override { stroke_.setStrokeThickness(pal_.borderWidth()); }
 
-  virtual void update() override {
+  void push(const std::array<float, nChannel>& peakAmplitude) {
+    for (size_t i = 0; i < nChannel; ++i) { peakAmp_[i] = std::max(peakAmp_[i], peakAmplitude[i]); }
+  }
+
+  virtual bool advance(int elapsed) override {
     constexpr int holdMilliseconds = 1000;
 
     // `*Tau` is time in seconds to reach 37% of input (x*e^-1).
     constexpr float peakTau = float(0.2);
     constexpr float holdTau = float(0.2);
 
-    const int elapsed = getMillisecondsSinceLastUpdate();
     const float dt = float(0.001) * elapsed;
     const float peakDecay = (dt > float(0)) ? std::exp(-dt / peakTau) : float(1);
     const float holdDecay = (dt > float(0)) ? std::exp(-dt / holdTau) : float(1);
@@ -103,8 +105,10 @@ public:
       if (value < std::numeric_limits<float>::epsilon()) { value = float(0); }
     };
 
+    bool isChanged = false;
     for (size_t i = 0; i < nChannel; ++i) {
-      const float amplitude = peakAmp_[i].exchange(float(0), std::memory_order_relaxed);
+      const auto previous = meter_[i];
+      const float amplitude = std::exchange(peakAmp_[i], float(0));
       const float db = ScaleTools::ampToDB(amplitude);
 
       meter_[i].peakN = std::max(decibelToNormalized(db), meter_[i].peakN * peakDecay);
@@ -115,10 +119,14 @@ public:
       if (meter_[i].holdN <= float(0)) {
         meter_[i].holdDecibel = -std::numeric_limits<float>::infinity();
       }
+
+      isChanged |= meter_[i].peakN != previous.peakN || meter_[i].holdN != previous.holdN
+        || meter_[i].holdDecibel != previous.holdDecibel;
     }
+    return isChanged;
   }
 
-  virtual void paint(juce::Graphics& ctx) override {
+  virtual void paintFrame(juce::Graphics& ctx) override {
     const auto fullBounds = getLocalBounds().toFloat();
     auto bounds = fullBounds;
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "Uhhyou/dsp/telemetry.hpp"
 #include "Uhhyou/scale.hpp"
 #include "Uhhyou/scaledparameter.hpp"
 
@@ -69,6 +70,15 @@ struct Scales {
     {61.0f, "61"},       {62.0f, "62"},       {63.0f, "63"},       {64.0f, "64"}};
 };
 
+// Values of a processing block sent to GUI. Delay times are in seconds.
+struct DisplayRecord {
+  std::array<float, nChannel> preSaturationPeak{};
+  std::array<float, nChannel> outputPeak{};
+  std::array<float, nChannel> lfoPhase{};
+  std::array<std::array<float, 2>, nChannel> delayTimeUpper{};
+  std::array<std::array<float, 2>, nChannel> delayTimeLower{};
+};
+
 struct ValueReceivers {
   std::atomic<float>* dryGain{};
   std::atomic<float>* wetGain{};
@@ -109,11 +119,7 @@ struct ValueReceivers {
   std::atomic<float>* noteGainRange{};
 
   // Internal values used for GUI.
-  std::array<std::atomic<float>, nChannel> displayPreSaturationPeak{};
-  std::array<std::atomic<float>, nChannel> displayOutputPeak{};
-  std::array<std::atomic<float>, nChannel> displayLfoPhase{};
-  std::array<std::array<std::atomic<float>, 2>, nChannel> displayDelayTimeUpper{};
-  std::array<std::array<std::atomic<float>, 2>, nChannel> displayDelayTimeLower{};
+  TelemetryRing<DisplayRecord, 512> displayTelemetry;
 };
 
 class ParameterStore {
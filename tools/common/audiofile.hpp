@@ -0,0 +1,50 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <limits>
+#include <memory>
+
+namespace Uhhyou {
+
+// Returns false if `file` can't be read. `sampleRate` is set on success.
+inline bool readAudioFile(const juce::File& file, juce::AudioBuffer<float>& buffer,
+                          double& sampleRate) {
+  juce::AudioFormatManager manager;
+  manager.registerBasicFormats();
+
+  std::unique_ptr<juce::AudioFormatReader> reader(manager.createReaderFor(file));
+  if (reader == nullptr) { return false; }
+
+  const auto length = reader->lengthInSamples;
+  if (length > std::numeric_limits<int>::max()) { return false; }
+
+  buffer.setSize(int(reader->numChannels), int(length), false, true, false);
+  if (!reader->read(&buffer, 0, int(length), 0, true, true)) { return false; }
+  sampleRate = reader->sampleRate;
+  return true;
+}
+
+// Writes 32-bit float WAV, so that samples round-trip without loss. Overwrites `file`.
+inline bool writeWavFile(const juce::File& file, const juce::AudioBuffer<float>& buffer,
+                         double sampleRate) {
+  if (!file.getParentDirectory().createDirectory()) { return false; }
+  if (file.existsAsFile() && !file.deleteFile()) { return false; }
+
+  std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+  if (stream == nullptr) { return false; }
+
+  juce::WavAudioFormat wav;
+  std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(
+    stream.get(), sampleRate, unsigned(buffer.getNumChannels()), 32, {}, 0));
+  if (writer == nullptr) { return false; }
+  stream.release(); // `writer` owns the stream from here.
+
+  return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+}
+
+} // namespace Uhhyou
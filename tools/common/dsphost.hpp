@@ -0,0 +1,122 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+
+// Resolved to the plugin given to `uhhyou_add_plugin_tool` in `tools/CMakeLists.txt`.
+#include "PluginProcessor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+namespace Uhhyou {
+
+// AmplitudeModulator takes carrier and modulator inputs. Other plugins take a stereo input.
+template<typename Dsp>
+inline void processDsp(Dsp& dsp, size_t length, const std::array<const float*, 4>& in,
+                       float* out0, float* out1) {
+  if constexpr (requires { dsp.process(length, in[0], in[1], in[2], in[3], out0, out1); }) {
+    dsp.process(length, in[0], in[1], in[2], in[3], out0, out1);
+  } else {
+    dsp.process(length, in[0], in[1], out0, out1);
+  }
+}
+
+/**
+Drives `Processor::dsp` without a host. Calls are made in the same order as
+`Processor::prepareToPlay` and `Processor::processBlock`, and the buffer is processed in-place as
+the plugin does.
+
+Note that `Processor` is held by pointer, because it's neither copyable nor movable.
+*/
+class DspHost {
+public:
+  std::unique_ptr<Processor> processor = std::make_unique<Processor>();
+
+  int getNumInputChannels() const { return processor->getTotalNumInputChannels(); }
+  int getNumOutputChannels() const { return processor->getTotalNumOutputChannels(); }
+
+  bool hasParameter(const juce::String& id) const {
+    return processor->param.tree.getParameter(id) != nullptr;
+  }
+
+  // Returns false if `id` is not found. `raw` is the value shown on GUI.
+  bool setParameter(const juce::String& id, float raw) {
+    auto prm = processor->param.tree.getParameter(id);
+    if (prm == nullptr) { return false; }
+    prm->setValueNotifyingHost(prm->convertTo0to1(raw));
+    return true;
+  }
+
+  // Returns false if `id` is not found.
+  bool setParameterNormalized(const juce::String& id, float normalized) {
+    auto prm = processor->param.tree.getParameter(id);
+    if (prm == nullptr) { return false; }
+    prm->setValueNotifyingHost(std::clamp(normalized, 0.0f, 1.0f));
+    return true;
+  }
+
+  // Reads the format written by `PresetManager::savePreset`. Returns false on invalid file.
+  bool loadPreset(const juce::File& file) {
+    auto xmlState = juce::parseXML(file);
+    auto& tree = processor->param.tree;
+    if (xmlState == nullptr || !xmlState->hasTagName(tree.state.getType())) { return false; }
+    tree.replaceState(juce::ValueTree::fromXml(*xmlState));
+    return true;
+  }
+
+  void setup(double sampleRate) { processor->dsp.setup(sampleRate); }
+  void reset() { processor->dsp.reset(); }
+  size_t getLatency() { return processor->dsp.getLatency(); }
+
+  /**
+  `input` must have `getNumInputChannels()` channels. `output` is resized to 2 channels and the
+  length of `input`. Parameters are read at the start of each block of `blockSize` samples.
+  */
+  void process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+               int blockSize) {
+    const int nInput = getNumInputChannels();
+    const int nOutput = getNumOutputChannels();
+    const int length = input.getNumSamples();
+    jassert(input.getNumChannels() == nInput);
+
+    work_.setSize(std::max(nInput, nOutput), length, false, false, true);
+    for (int ch = 0; ch < work_.getNumChannels(); ++ch) {
+      if (ch < nInput) {
+        work_.copyFrom(ch, 0, input, ch, 0, length);
+      } else {
+        work_.clear(ch, 0, length);
+      }
+    }
+
+    juce::ScopedNoDenormals noDenormals;
+    auto& dsp = processor->dsp;
+    blockSize = std::max(blockSize, 1);
+    for (int offset = 0; offset < length; offset += blockSize) {
+      const int count = std::min(blockSize, length - offset);
+
+      std::array<const float*, 4> in{};
+      for (int ch = 0; ch < std::min(nInput, int(in.size())); ++ch) {
+        in[size_t(ch)] = work_.getReadPointer(ch, offset);
+      }
+      auto out0 = work_.getWritePointer(0, offset);
+      auto out1 = work_.getWritePointer(1, offset);
+
+      dsp.setParameters();
+      processDsp(dsp, size_t(count), in, out0, out1);
+    }
+
+    output.setSize(2, length, false, false, true);
+    output.copyFrom(0, 0, work_, 0, 0, length);
+    output.copyFrom(1, 0, work_, 1, 0, length);
+  }
+
+private:
+  juce::AudioBuffer<float> work_;
+};
+
+} // namespace Uhhyou
@@ -0,0 +1,91 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Uhhyou {
+
+/**
+Runs a fixed set of tasks on `nWorker` threads. Tasks are dealt to workers in round-robin. A worker
+takes tasks from the back of its own queue, and steals from the front of other queues when its
+queue is empty. This keeps all cores busy when the cost of tasks varies, like rendering files of
+different lengths.
+
+Tasks can't push new tasks. `run` returns when all queues are empty.
+*/
+class WorkStealingPool {
+public:
+  // The argument is the index of the worker, in [0, nWorker).
+  using Task = std::function<void(size_t)>;
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  size_t nextQueue_ = 0;
+
+  std::optional<Task> popOwn(size_t index) {
+    auto& q = *queues_[index];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) { return std::nullopt; }
+    auto task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return task;
+  }
+
+  std::optional<Task> steal(size_t thief) {
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+      auto& q = *queues_[(thief + offset) % queues_.size()];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (q.tasks.empty()) { continue; }
+      auto task = std::move(q.tasks.front());
+      q.tasks.pop_front();
+      return task;
+    }
+    return std::nullopt;
+  }
+
+  void work(size_t index) {
+    while (true) {
+      auto task = popOwn(index);
+      if (!task) { task = steal(index); }
+      if (!task) { return; }
+      (*task)(index);
+    }
+  }
+
+public:
+  explicit WorkStealingPool(size_t nWorker) {
+    queues_.resize(std::max(nWorker, size_t(1)));
+    for (auto& q : queues_) { q = std::make_unique<Queue>(); }
+  }
+
+  size_t getNumWorkers() const { return queues_.size(); }
+
+  void push(Task task) {
+    queues_[nextQueue_]->tasks.push_back(std::move(task));
+    nextQueue_ = (nextQueue_ + 1) % queues_.size();
+  }
+
+  // Blocks until all tasks are done. Worker 0 runs on the calling thread.
+  void run() {
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < queues_.size(); ++i) { threads.emplace_back([this, i]() { work(i); }); }
+    work(0);
+    for (auto& t : threads) { t.join(); }
+  }
+};
+
+} // namespace Uhhyou
@@ -0,0 +1,405 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/*
+Golden-output regression test for `DSPCore`.
+
+Each case in `<corpusDir>/cases.json` is rendered through `Processor::dsp`, and the output is
+compared to the reference `<corpusDir>/<case name>.wav`. See `tools/README.md` for the format.
+
+Usage:
+
+```
+dspregression_<Plugin> <corpusDir> [--update] [--case <name>]
+```
+
+- `--update` overwrites references with the current output.
+- `--case` runs only the named case.
+
+Exit code is 0 when all cases pass, 1 on failure, and 2 on invalid usage or corpus. A missing
+reference is a failure.
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include "audiofile.hpp"
+#include "dsphost.hpp"
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using json = nlohmann::json;
+
+// splitmix64. Standard distributions are implementation defined, so noise is made from bits.
+class NoiseGenerator {
+  uint64_t state_;
+
+public:
+  explicit NoiseGenerator(uint64_t seed) : state_(seed) {}
+
+  // Range is [-1, 1).
+  double process() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    z = z ^ (z >> 31);
+    return double(z >> 11) * 0x1.0p-52 - 1.0;
+  }
+};
+
+struct Tolerance {
+  enum class Mode { exact, ulp, snr };
+
+  Mode mode = Mode::exact;
+  int64_t ulp = 0;
+  double snrDecibel = 0;
+};
+
+struct TestCase {
+  std::string name;
+  double sampleRate = 48000;
+  int blockSize = 512;
+  int length = 48000;
+  std::vector<json> inputs; // One generator for each input bus.
+  std::vector<std::pair<std::string, float>> parameters;
+  Tolerance tolerance;
+};
+
+struct Divergence {
+  int channel = 0;
+  int index = 0;
+  float expected = 0;
+  float actual = 0;
+};
+
+struct CompareResult {
+  bool passed = true;
+  std::string reason;
+  std::optional<Divergence> first; // First sample that breaks the tolerance.
+  int64_t maxUlp = 0;
+  double snrDecibel = std::numeric_limits<double>::infinity();
+};
+
+// `std::isfinite` can't be used, because release build has `-ffast-math`.
+bool isFiniteBits(float x) {
+  return (std::bit_cast<uint32_t>(x) & 0x7f800000u) != 0x7f800000u;
+}
+
+// Distance in units in the last place. +0 and -0 are the same.
+int64_t ulpDistance(float a, float b) {
+  auto toOrdered = [](float x) {
+    const auto i = int64_t(std::bit_cast<int32_t>(x));
+    return i >= 0 ? i : int64_t(std::numeric_limits<int32_t>::min()) - i;
+  };
+  const auto d = toOrdered(a) - toOrdered(b);
+  return d >= 0 ? d : -d;
+}
+
+Tolerance parseTolerance(const json& j) {
+  Tolerance tol;
+  const auto mode = j.at("mode").get<std::string>();
+  if (mode == "exact") {
+    tol.mode = Tolerance::Mode::exact;
+  } else if (mode == "ulp") {
+    tol.mode = Tolerance::Mode::ulp;
+    tol.ulp = j.at("ulp").get<int64_t>();
+  } else if (mode == "snr") {
+    tol.mode = Tolerance::Mode::snr;
+    tol.snrDecibel = j.at("decibel").get<double>();
+  } else {
+    throw std::runtime_error(std::format("Unknown tolerance mode \"{}\".", mode));
+  }
+  return tol;
+}
+
+std::vector<TestCase> parseCorpus(const juce::File& file) {
+  std::ifstream stream(file.getFullPathName().toStdString());
+  if (!stream) {
+    throw std::runtime_error(
+      std::format("Failed to open {}.", file.getFullPathName().toStdString()));
+  }
+  const auto root = json::parse(stream);
+
+  std::vector<TestCase> cases;
+  for (const auto& c : root.at("cases")) {
+    TestCase tc;
+    tc.name = c.at("name").get<std::string>();
+    tc.sampleRate = c.value("sampleRate", tc.sampleRate);
+    tc.blockSize = c.value("blockSize", tc.blockSize);
+    tc.length = c.value("length", tc.length);
+
+    const auto& input = c.at("input");
+    if (input.is_array()) {
+      for (const auto& bus : input) { tc.inputs.push_back(bus); }
+    } else {
+      tc.inputs.push_back(input);
+    }
+
+    if (c.contains("parameters")) {
+      for (const auto& [id, raw] : c.at("parameters").items()) {
+        tc.parameters.emplace_back(id, raw.get<float>());
+      }
+    }
+
+    tc.tolerance = parseTolerance(c.at("tolerance"));
+
+    if (tc.sampleRate <= 0 || tc.blockSize <= 0 || tc.length <= 0) {
+      throw std::runtime_error(std::format("Case \"{}\" has non-positive size.", tc.name));
+    }
+    cases.push_back(std::move(tc));
+  }
+  return cases;
+}
+
+// Fills `channel` of `buffer` by the generator `gen`. Noise seed is offset by `channel`, so that
+// channels are decorrelated.
+void generateInput(const json& gen, juce::AudioBuffer<float>& buffer, int channel,
+                   double sampleRate) {
+  const auto type = gen.at("type").get<std::string>();
+  const double amp = gen.value("amplitude", 0.5);
+  const int length = buffer.getNumSamples();
+  auto dest = buffer.getWritePointer(channel);
+
+  constexpr double twopi = 2 * std::numbers::pi_v<double>;
+  if (type == "silence") {
+    buffer.clear(channel, 0, length);
+  } else if (type == "impulse") {
+    buffer.clear(channel, 0, length);
+    const int position = gen.value("position", 0);
+    if (position >= 0 && position < length) { dest[position] = float(amp); }
+  } else if (type == "sine") {
+    const double freq = gen.at("frequencyHz").get<double>();
+    for (int i = 0; i < length; ++i) {
+      dest[i] = float(amp * std::sin(twopi * freq * double(i) / sampleRate));
+    }
+  } else if (type == "sweep") {
+    // Exponential sweep over the whole length.
+    const double f0 = gen.at("startHz").get<double>();
+    const double f1 = gen.at("endHz").get<double>();
+    const double duration = double(length) / sampleRate;
+    const double k = std::log(f1 / f0);
+    for (int i = 0; i < length; ++i) {
+      const double t = double(i) / sampleRate;
+      const double phase = twopi * f0 * duration / k * (std::exp(t / duration * k) - 1);
+      dest[i] = float(amp * std::sin(phase));
+    }
+  } else if (type == "noise") {
+    NoiseGenerator rng(gen.value("seed", uint64_t(0)) + uint64_t(channel));
+    for (int i = 0; i < length; ++i) { dest[i] = float(amp * rng.process()); }
+  } else {
+    throw std::runtime_error(std::format("Unknown input type \"{}\".", type));
+  }
+}
+
+juce::AudioBuffer<float> render(const TestCase& tc) {
+  Uhhyou::DspHost host;
+
+  for (const auto& [id, raw] : tc.parameters) {
+    if (!host.setParameter(id, raw)) {
+      throw std::runtime_error(
+        std::format("Case \"{}\" has unknown parameter \"{}\".", tc.name, id));
+    }
+  }
+
+  const int nInput = host.getNumInputChannels();
+  juce::AudioBuffer<float> input(nInput, tc.length);
+  for (int ch = 0; ch < nInput; ++ch) {
+    const auto& gen = tc.inputs[std::min(size_t(ch / 2), tc.inputs.size() - 1)];
+    generateInput(gen, input, ch, tc.sampleRate);
+  }
+
+  host.setup(tc.sampleRate);
+
+  juce::AudioBuffer<float> output;
+  host.process(input, output, tc.blockSize);
+  return output;
+}
+
+CompareResult compare(const juce::AudioBuffer<float>& expected,
+                      const juce::AudioBuffer<float>& actual, const Tolerance& tol) {
+  CompareResult result;
+  if (expected.getNumChannels() != actual.getNumChannels()
+      || expected.getNumSamples() != actual.getNumSamples()) {
+    result.passed = false;
+    result.reason = std::format("Size mismatch. Expected {} channels and {} samples, but got {} "
+                                "channels and {} samples.",
+                                expected.getNumChannels(), expected.getNumSamples(),
+                                actual.getNumChannels(), actual.getNumSamples());
+    return result;
+  }
+
+  // Samples are scanned in time order, so the first divergence is the earliest one across all
+  // channels.
+  double signalPower = 0;
+  double errorPower = 0;
+  for (int i = 0; i < expected.getNumSamples(); ++i) {
+    for (int ch = 0; ch < expected.getNumChannels(); ++ch) {
+      const float e = expected.getSample(ch, i);
+      const float a = actual.getSample(ch, i);
+
+      bool isDivergent = false;
+      if (!isFiniteBits(a)) {
+        isDivergent = true;
+        if (result.passed) { result.reason = "Output is not finite."; }
+        result.passed = false;
+      } else {
+        const auto ulp = ulpDistance(e, a);
+        result.maxUlp = std::max(result.maxUlp, ulp);
+
+        const double diff = double(a) - double(e);
+        signalPower += double(e) * double(e);
+        errorPower += diff * diff;
+
+        switch (tol.mode) {
+          case Tolerance::Mode::exact:
+            isDivergent = std::bit_cast<uint32_t>(e) != std::bit_cast<uint32_t>(a);
+            break;
+          case Tolerance::Mode::ulp:
+            isDivergent = ulp > tol.ulp;
+            break;
+          case Tolerance::Mode::snr:
+            isDivergent = ulp != 0; // Only for the report. Pass or fail is decided by SNR.
+            break;
+        }
+      }
+
+      if (isDivergent && !result.first) { result.first = Divergence{ch, i, e, a}; }
+    }
+  }
+
+  if (errorPower > 0) {
+    result.snrDecibel = signalPower > 0 ? 10 * std::log10(signalPower / errorPower)
+                                        : -std::numeric_limits<double>::infinity();
+  }
+
+  if (!result.passed) { return result; }
+  switch (tol.mode) {
+    case Tolerance::Mode::exact:
+    case Tolerance::Mode::ulp:
+      result.passed = !result.first.has_value();
+      if (!result.passed) { result.reason = "Tolerance exceeded."; }
+      break;
+    case Tolerance::Mode::snr:
+      result.passed = result.snrDecibel >= tol.snrDecibel;
+      if (!result.passed) {
+        result.reason = std::format("SNR {:.2f} dB is below {:.2f} dB.", result.snrDecibel,
+                                    tol.snrDecibel);
+      }
+      break;
+  }
+  return result;
+}
+
+void printResult(const TestCase& tc, const CompareResult& result) {
+  const auto summary = std::format("maxUlp={}, snr={:.2f} dB", result.maxUlp, result.snrDecibel);
+  if (result.passed) {
+    std::cout << std::format("PASS {} ({})\n", tc.name, summary);
+    return;
+  }
+
+  std::cout << std::format("FAIL {}: {} ({})\n", tc.name, result.reason, summary);
+  if (result.first) {
+    const auto& d = *result.first;
+    std::cout << std::format("  First divergent sample: channel {}, index {} ({:.6f} s), "
+                             "expected {:.9g}, actual {:.9g}, ulp {}\n",
+                             d.channel, d.index, double(d.index) / tc.sampleRate, d.expected,
+                             d.actual, ulpDistance(d.expected, d.actual));
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  std::optional<juce::File> corpusDir;
+  std::optional<std::string> caseFilter;
+  bool isUpdating = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    if (arg == "--update") {
+      isUpdating = true;
+    } else if (arg == "--case" && i + 1 < argc) {
+      caseFilter = argv[++i];
+    } else {
+      corpusDir = juce::File::getCurrentWorkingDirectory().getChildFile(argv[i]);
+    }
+  }
+  if (!corpusDir) {
+    std::cerr << std::format("Usage: {} <corpusDir> [--update] [--case <name>]\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<TestCase> cases;
+  try {
+    cases = parseCorpus(corpusDir->getChildFile("cases.json"));
+  } catch (const std::exception& e) {
+    std::cerr << std::format("Failed to read corpus: {}\n", e.what());
+    return 2;
+  }
+
+  int nRun = 0;
+  int nFail = 0;
+  for (const auto& tc : cases) {
+    if (caseFilter && *caseFilter != tc.name) { continue; }
+    ++nRun;
+
+    juce::AudioBuffer<float> actual;
+    try {
+      actual = render(tc);
+    } catch (const std::exception& e) {
+      std::cout << std::format("FAIL {}: {}\n", tc.name, e.what());
+      ++nFail;
+      continue;
+    }
+
+    const auto refFile = corpusDir->getChildFile(juce::String(tc.name) + ".wav");
+    if (isUpdating) {
+      if (Uhhyou::writeWavFile(refFile, actual, tc.sampleRate)) {
+        std::cout << std::format("UPDATE {}\n", tc.name);
+      } else {
+        std::cout << std::format("FAIL {}: Failed to write reference.\n", tc.name);
+        ++nFail;
+      }
+      continue;
+    }
+
+    juce::AudioBuffer<float> expected;
+    double refSampleRate = 0;
+    if (!Uhhyou::readAudioFile(refFile, expected, refSampleRate)) {
+      std::cout << std::format("FAIL {}: Reference {} is missing. Run with --update.\n",
+                               tc.name, refFile.getFullPathName().toStdString());
+      ++nFail;
+      continue;
+    }
+
+    const auto result = compare(expected, actual, tc.tolerance);
+    printResult(tc, result);
+    if (!result.passed) { ++nFail; }
+  }
+
+  if (caseFilter && nRun == 0) {
+    std::cerr << std::format("Case \"{}\" is not found.\n", *caseFilter);
+    return 2;
+  }
+
+  std::cout << std::format("{} of {} cases passed.\n", nRun - nFail, nRun);
+  return nFail > 0 ? 1 : 0;
+}
@@ -0,0 +1,244 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/*
+Offline batch renderer. Renders audio files through `DSPCore` with a preset, in parallel.
+
+Usage:
+
+```
+dsprender_<Plugin> --preset <file.xml> --output <dir> [options] <input>...
+```
+
+Options:
+
+- `--jobs <n>`: Number of worker threads. Default is the number of CPU cores.
+- `--block-size <n>`: Samples per `DSPCore::process` call. Default is 2048.
+- `--tail <seconds>`: Renders extra silence after the end of input. Default is 0.
+- `--keep-oversampling`: Uses the oversampling of the preset. By default, the highest
+  oversampling is used, because there's no real-time constraint.
+
+Output is 32-bit float WAV with the same name as input. When inputs share a name, like `a.flac`
+and `a.wav` or the same name in different directories, suffixes are added in the order of
+arguments, like `a.wav` and `a_1.wav`. Suffix is also added when the output overwrites an input.
+The same input can't be given twice. Latency is compensated.
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include "audiofile.hpp"
+#include "dsphost.hpp"
+#include "workstealingpool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+  juce::File preset;
+  juce::File outputDir;
+  std::vector<juce::File> inputs;
+  size_t nJob = std::max(std::thread::hardware_concurrency(), 1u);
+  int blockSize = 2048;
+  double tailSecond = 0;
+  bool keepOversampling = false;
+};
+
+std::optional<Options> parseArguments(int argc, char* argv[]) {
+  Options opt;
+  bool hasPreset = false;
+  bool hasOutput = false;
+
+  auto cwd = juce::File::getCurrentWorkingDirectory();
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--preset" && hasValue) {
+      opt.preset = cwd.getChildFile(argv[++i]);
+      hasPreset = true;
+    } else if (arg == "--output" && hasValue) {
+      opt.outputDir = cwd.getChildFile(argv[++i]);
+      hasOutput = true;
+    } else if (arg == "--jobs" && hasValue) {
+      opt.nJob = size_t(std::max(std::atoi(argv[++i]), 1));
+    } else if (arg == "--block-size" && hasValue) {
+      opt.blockSize = std::max(std::atoi(argv[++i]), 1);
+    } else if (arg == "--tail" && hasValue) {
+      opt.tailSecond = std::max(std::atof(argv[++i]), 0.0);
+    } else if (arg == "--keep-oversampling") {
+      opt.keepOversampling = true;
+    } else if (arg.starts_with("--")) {
+      std::cerr << std::format("Unknown option {}.\n", arg);
+      return std::nullopt;
+    } else {
+      opt.inputs.push_back(cwd.getChildFile(argv[i]));
+    }
+  }
+
+  if (!hasPreset || !hasOutput || opt.inputs.empty()) { return std::nullopt; }
+  return opt;
+}
+
+// Returns output file of each input, or `std::nullopt` when an input is given twice. Names are
+// compared in lower case, because some file systems are case-insensitive. Inputs in the output
+// directory also take their names, so that no input is overwritten.
+std::optional<std::vector<juce::File>> makeOutputFiles(const Options& opt) {
+  std::set<juce::String> inputPaths;
+  std::set<juce::String> taken;
+  for (const auto& inFile : opt.inputs) {
+    if (!inputPaths.insert(inFile.getFullPathName()).second) {
+      std::cerr << std::format("Input {} is given twice.\n",
+                               inFile.getFullPathName().toStdString());
+      return std::nullopt;
+    }
+    if (inFile.getParentDirectory() == opt.outputDir) {
+      taken.insert(inFile.getFileName().toLowerCase());
+    }
+  }
+
+  std::vector<juce::File> outputs;
+  for (const auto& inFile : opt.inputs) {
+    const auto stem = inFile.getFileNameWithoutExtension();
+    auto name = stem + ".wav";
+    for (int suffix = 1; !taken.insert(name.toLowerCase()).second; ++suffix) {
+      name = stem + "_" + juce::String(suffix) + ".wav";
+    }
+    outputs.push_back(opt.outputDir.getChildFile(name));
+  }
+  return outputs;
+}
+
+struct RenderResult {
+  bool success = false;
+  std::string message;
+  double elapsedSecond = 0;
+  double audioSecond = 0;
+};
+
+RenderResult renderFile(Uhhyou::DspHost& host, const Options& opt, const juce::File& inFile,
+                        const juce::File& outFile) {
+  RenderResult result;
+  const auto start = std::chrono::steady_clock::now();
+
+  juce::AudioBuffer<float> source;
+  double sampleRate = 0;
+  if (!Uhhyou::readAudioFile(inFile, source, sampleRate) || source.getNumChannels() <= 0) {
+    result.message = "Failed to read input.";
+    return result;
+  }
+
+  // Latency depends on sample rate and oversampling, so it's taken after `setup`.
+  host.setup(sampleRate);
+  const int latency = int(host.getLatency());
+  const int tail = int(opt.tailSecond * sampleRate);
+  const int length = source.getNumSamples();
+
+  // Missing channels repeat the channels of the file. AmplitudeModulator takes 4 channels, and
+  // channel 2 and 3 are the modulator.
+  const int nInput = host.getNumInputChannels();
+  juce::AudioBuffer<float> input(nInput, length + tail + latency);
+  input.clear();
+  for (int ch = 0; ch < nInput; ++ch) {
+    input.copyFrom(ch, 0, source, ch % source.getNumChannels(), 0, length);
+  }
+
+  juce::AudioBuffer<float> rendered;
+  host.process(input, rendered, opt.blockSize);
+
+  juce::AudioBuffer<float> output(rendered.getNumChannels(), length + tail);
+  for (int ch = 0; ch < output.getNumChannels(); ++ch) {
+    output.copyFrom(ch, 0, rendered, ch, latency, output.getNumSamples());
+  }
+
+  if (!Uhhyou::writeWavFile(outFile, output, sampleRate)) {
+    result.message = "Failed to write output.";
+    return result;
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  result.success = true;
+  result.elapsedSecond = std::chrono::duration<double>(end - start).count();
+  result.audioSecond = double(output.getNumSamples()) / sampleRate;
+  return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  auto opt = parseArguments(argc, argv);
+  if (!opt) {
+    std::cerr << std::format("Usage: {} --preset <file.xml> --output <dir> [--jobs <n>] "
+                             "[--block-size <n>] [--tail <seconds>] [--keep-oversampling] "
+                             "<input>...\n",
+                             argv[0]);
+    return 2;
+  }
+
+  if (!opt->outputDir.createDirectory()) {
+    std::cerr << std::format("Failed to create {}.\n",
+                             opt->outputDir.getFullPathName().toStdString());
+    return 2;
+  }
+
+  const auto outFiles = makeOutputFiles(*opt);
+  if (!outFiles) { return 2; }
+
+  // Each worker owns a host. Hosts are prepared on this thread, so that the parameter tree is
+  // only touched here. Workers only call `DSPCore` methods.
+  const size_t nWorker = std::min(opt->nJob, opt->inputs.size());
+  std::vector<Uhhyou::DspHost> hosts(nWorker);
+  for (auto& host : hosts) {
+    if (!host.loadPreset(opt->preset)) {
+      std::cerr << std::format("Invalid preset {}.\n", opt->preset.getFullPathName().toStdString());
+      return 2;
+    }
+  }
+  if (!opt->keepOversampling) {
+    if (hosts.front().hasParameter("oversampling")) {
+      for (auto& host : hosts) { host.setParameterNormalized("oversampling", 1.0f); }
+    } else {
+      std::cerr << "Warning: Plugin doesn't have oversampling. It's rendered at base rate.\n";
+    }
+  }
+
+  std::mutex logMutex;
+  std::atomic<int> nFail{0};
+  Uhhyou::WorkStealingPool pool(nWorker);
+  for (size_t idx = 0; idx < opt->inputs.size(); ++idx) {
+    pool.push([&, idx](size_t worker) {
+      const auto& inFile = opt->inputs[idx];
+      const auto& outFile = (*outFiles)[idx];
+
+      const auto result = renderFile(hosts[worker], *opt, inFile, outFile);
+
+      std::lock_guard<std::mutex> lock(logMutex);
+      const auto path = inFile.getFullPathName().toStdString();
+      if (result.success) {
+        std::cout << std::format("Done: {} ({:.2f} s, {:.1f}x real-time)\n", path,
+                                 result.elapsedSecond,
+                                 result.audioSecond / std::max(result.elapsedSecond, 1e-9));
+      } else {
+        std::cout << std::format("Failed: {}: {}\n", path, result.message);
+        ++nFail;
+      }
+    });
+  }
+  pool.run();
+
+  return nFail.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,275 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/*
+Paint cost of mouse hover and keyboard focus on the editor.
+
+The editor is opened in a desktop window, and events are sent through its peer in the same way as
+the platform does. Areas passed to `repaint` are recorded by a `juce::CachedComponentImage` set on
+the editor, which also stops them from reaching the peer. Scenarios:
+
+- `enter`: Mouse cursor is moved to the center of each child of the editor in order.
+- `move`: Mouse cursor is moved inside the current child, to 1/6 of its width. This crosses the
+  buttons of the preset manager.
+- `focus`: Keyboard focus is moved to each child that wants it.
+
+For each event, the editor is painted into an image in 2 ways.
+
+- `full`: Whole editor. This is what happened when hover and focus repainted the whole editor.
+- `targeted`: Only the recorded areas.
+
+Images before and after each event are also compared. Changed pixels outside of the recorded areas
+are counted as `missed`, which means that the invalidation is too small. The ratio of changed area
+to recorded area shows how much it's too large.
+
+A display is required. On Linux without desktop, run it with `xvfb-run`.
+
+Usage:
+
+```
+editorpaintbench_<Plugin> [--rounds <n>]
+```
+
+Exit code is 0 when no pixel is missed.
+*/
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include "PluginEditor.hpp"
+#include "PluginProcessor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Records areas to repaint in the coordinate of the editor. Children forward their `repaint` to the
+// editor, so all of them end up here. Returning `false` stops the repaint from reaching the peer.
+class RepaintRecorder final : public juce::CachedComponentImage {
+public:
+  RepaintRecorder(juce::Component& owner, juce::RectangleList<int>& dirty)
+      : owner_(owner), dirty_(dirty) {}
+
+  void paint(juce::Graphics&) override {}
+
+  bool invalidateAll() override {
+    dirty_.add(owner_.getLocalBounds());
+    return false;
+  }
+
+  bool invalidate(const juce::Rectangle<int>& area) override {
+    dirty_.add(area);
+    return false;
+  }
+
+  void releaseResources() override {}
+
+private:
+  juce::Component& owner_;
+  juce::RectangleList<int>& dirty_;
+};
+
+struct Result {
+  size_t nEvent = 0;
+  double fullMs = 0;
+  double targetedMs = 0;
+  double dirtyArea = 0;
+  double changedArea = 0;
+  uint64_t nMissed = 0;
+};
+
+template<typename Fn> double measureMs(Fn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double getArea(const juce::RectangleList<int>& list) {
+  double sum = 0;
+  for (const auto& rect : list) { sum += double(rect.getWidth()) * double(rect.getHeight()); }
+  return sum;
+}
+
+class Bench {
+public:
+  explicit Bench(juce::Component& editor)
+      : editor_(editor),
+        image_(juce::Image::ARGB, editor.getWidth(), editor.getHeight(), true),
+        previous_(juce::Image::ARGB, editor.getWidth(), editor.getHeight(), true) {
+    attachRecorder();
+  }
+
+  ~Bench() { editor_.setCachedComponentImage(nullptr); }
+
+  // Sends `event`, and measures the paint of the areas invalidated by it.
+  void run(Result& result, std::function<void()> event) {
+    paint(previous_, nullptr);
+
+    dirty_.clear();
+    event();
+    const auto dirty = dirty_;
+    dirty_.clear();
+
+    result.fullMs += paint(image_, nullptr);
+    result.targetedMs += paint(image_, &dirty);
+
+    // `image_` is painted again, because the targeted paint leaves other areas as they were.
+    paint(image_, nullptr);
+    countChange(result, dirty);
+
+    result.dirtyArea += getArea(dirty);
+    ++result.nEvent;
+  }
+
+private:
+  juce::Component& editor_;
+  juce::Image image_;
+  juce::Image previous_;
+  juce::RectangleList<int> dirty_;
+
+  void attachRecorder() {
+    editor_.setCachedComponentImage(new RepaintRecorder(editor_, dirty_));
+    dirty_.clear(); // `setCachedComponentImage` repaints the whole editor.
+  }
+
+  // A cached image replaces the paint of the editor, so the recorder is removed while painting.
+  double paint(juce::Image& image, const juce::RectangleList<int>* clip) {
+    editor_.setCachedComponentImage(nullptr);
+
+    juce::Graphics ctx(image);
+    if (clip != nullptr) { ctx.reduceClipRegion(*clip); }
+    const double elapsedMs = measureMs([&]() { editor_.paintEntireComponent(ctx, false); });
+
+    attachRecorder();
+    return elapsedMs;
+  }
+
+  void countChange(Result& result, const juce::RectangleList<int>& dirty) {
+    const juce::Image::BitmapData before(previous_, juce::Image::BitmapData::readOnly);
+    const juce::Image::BitmapData after(image_, juce::Image::BitmapData::readOnly);
+    for (int y = 0; y < image_.getHeight(); ++y) {
+      for (int x = 0; x < image_.getWidth(); ++x) {
+        if (before.getPixelColour(x, y) == after.getPixelColour(x, y)) { continue; }
+        result.changedArea += 1;
+        if (!dirty.containsPoint(x, y)) { ++result.nMissed; }
+      }
+    }
+  }
+};
+
+// Children which cover the whole editor, like the focus ring overlay, are skipped.
+std::vector<juce::Component*> collectWidgets(juce::Component& editor) {
+  std::vector<juce::Component*> widgets;
+  for (auto* child : editor.getChildren()) {
+    if (!child->isVisible() || child->getBounds() == editor.getLocalBounds()) { continue; }
+    widgets.push_back(child);
+  }
+  return widgets;
+}
+
+void moveMouse(juce::ComponentPeer& peer, juce::Point<float> position) {
+  peer.handleMouseEvent(juce::MouseInputSource::InputSourceType::mouse, position,
+                        juce::ModifierKeys(), juce::MouseInputSource::defaultPressure,
+                        juce::MouseInputSource::defaultOrientation,
+                        juce::Time::currentTimeMillis());
+}
+
+void pumpMessages(int milliseconds) {
+  juce::MessageManager::getInstance()->runDispatchLoopUntil(milliseconds);
+}
+
+void printResult(std::string_view name, const Result& r) {
+  if (r.nEvent == 0) {
+    std::cout << std::format("{:6}: no event.\n", name);
+    return;
+  }
+  const double n = double(r.nEvent);
+  std::cout << std::format(
+    "{:6}: {} events, full {:.4f} ms, targeted {:.4f} ms, ratio {:.3f}. "
+    "Per event: {:.0f} px invalidated, {:.0f} px changed, {} px missed in total.\n",
+    name, r.nEvent, r.fullMs / n, r.targetedMs / n, r.targetedMs / r.fullMs, r.dirtyArea / n,
+    r.changedArea / n, r.nMissed);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  int nRound = 5;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    if (arg == "--rounds" && i + 1 < argc) {
+      nRound = std::max(std::atoi(argv[++i]), 1);
+    } else {
+      std::cerr << std::format("Usage: {} [--rounds <n>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  auto processor = std::make_unique<Processor>();
+  auto editor = std::make_unique<Uhhyou::Editor>(*processor);
+  editor->setVisible(true);
+  editor->addToDesktop(0);
+  auto* peer = editor->getPeer();
+  if (peer == nullptr) {
+    std::cerr << "Failed to open a window. A display is required.\n";
+    return 1;
+  }
+
+  // Editor ignores mouse for a while after resizing, and animated displays settle after a few
+  // frames without input. See `EditorBase::resized` and `AnimationScheduler`.
+  pumpMessages(1000);
+
+  const auto widgets = collectWidgets(*editor);
+  if (widgets.empty()) {
+    std::cerr << "Editor has no widget.\n";
+    return 1;
+  }
+
+  Result enter;
+  Result move;
+  Result focus;
+  {
+    Bench bench(*editor);
+    for (int round = 0; round < nRound; ++round) {
+      for (auto* widget : widgets) {
+        const auto bounds = widget->getBounds().toFloat();
+        bench.run(enter, [&]() { moveMouse(*peer, bounds.getCentre()); });
+        bench.run(move, [&]() {
+          moveMouse(*peer, {bounds.getX() + bounds.getWidth() / 6, bounds.getCentreY()});
+        });
+      }
+    }
+    moveMouse(*peer, {-1.0f, -1.0f});
+
+    // Focus change is notified asynchronously by `juce::Desktop`.
+    for (auto* widget : widgets) {
+      if (!widget->getWantsKeyboardFocus()) { continue; }
+      bench.run(focus, [&]() {
+        widget->grabKeyboardFocus();
+        pumpMessages(20);
+      });
+    }
+  }
+
+  std::cout << std::format("widgets: {}, rounds: {}, size: {}x{}\n", widgets.size(), nRound,
+                           editor->getWidth(), editor->getHeight());
+  printResult("enter", enter);
+  printResult("move", move);
+  printResult("focus", focus);
+
+  editor->removeFromDesktop();
+  return enter.nMissed + move.nMissed + focus.nMissed == 0 ? 0 : 1;
+}
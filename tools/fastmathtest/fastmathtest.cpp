@@ -0,0 +1,172 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/*
+Accuracy test of `Uhhyou::FastMath`.
+
+Each function is compared to the standard library over the input range used in plugins. Maximum
+error is checked against the approximation error written in `fastmath.hpp`, plus headroom for the
+rounding of `double`. Time per call is also printed for reference, but it's not tested.
+
+Exit code is 0 when all errors are within bounds.
+*/
+
+#include "Uhhyou/dsp/fastmath.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace FastMath = Uhhyou::FastMath;
+
+constexpr double pi = std::numbers::pi_v<double>;
+constexpr size_t nSample = 1 << 20;
+
+enum class ErrorKind { absolute, relative };
+
+using Inputs = std::vector<std::array<double, 2>>; // `[1]` is only used by `atan2`.
+
+Inputs linspace(double lo, double hi) {
+  Inputs inputs(nSample);
+  for (size_t i = 0; i < nSample; ++i) {
+    inputs[i][0] = lo + (hi - lo) * double(i) / double(nSample - 1);
+    inputs[i][1] = 0;
+  }
+  return inputs;
+}
+
+// Points on circles of various radii, to cover all octants of `atan2`.
+Inputs circle() {
+  std::mt19937_64 rng(0);
+  std::uniform_real_distribution<double> logRadius(-20.0, 20.0);
+  Inputs inputs(nSample);
+  for (size_t i = 0; i < nSample; ++i) {
+    const double theta = 2 * pi * double(i) / double(nSample);
+    const double r = std::exp2(logRadius(rng));
+    inputs[i] = {r * std::sin(theta), r * std::cos(theta)};
+  }
+  inputs[0] = {0.0, 0.0};
+  return inputs;
+}
+
+// Block of inputs is processed repeatedly to stay in cache. Outputs are written to a buffer, so
+// that the loop can be vectorized.
+template<typename Fn> double measureNanosecond(const Inputs& inputs, Fn fn) {
+  constexpr size_t blockSize = 4096;
+  std::array<double, blockSize> outputs{};
+  double checksum = 0;
+  size_t nCall = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t offset = 0; offset + blockSize <= inputs.size(); offset += 1024) {
+    const auto block = inputs.data() + offset;
+    for (size_t i = 0; i < blockSize; ++i) { outputs[i] = fn(block[i][0], block[i][1]); }
+    for (const auto& y : outputs) { checksum += y; }
+    nCall += blockSize;
+  }
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  volatile double sink = checksum; // Prevents the loop from being removed.
+  (void)sink;
+  return elapsed.count() / double(nCall);
+}
+
+template<typename Reference, typename Approximation>
+bool runCase(const std::string& name, ErrorKind kind, double bound, const Inputs& inputs,
+             Reference reference, Approximation approximation) {
+  double maxError = 0;
+  double worstInput = 0;
+  for (const auto& x : inputs) {
+    const double ref = reference(x[0], x[1]);
+    const double approx = approximation(x[0], x[1]);
+    double error = std::abs(approx - ref);
+    if (kind == ErrorKind::relative && ref != 0) { error /= std::abs(ref); }
+    if (!(error <= maxError)) {
+      maxError = error;
+      worstInput = x[0];
+    }
+  }
+
+  const double refNs = measureNanosecond(inputs, reference);
+  const double approxNs = measureNanosecond(inputs, approximation);
+
+  const bool passed = maxError <= bound;
+  std::cout << std::format(
+    "{} {:<16} {} error {:.3e} (bound {:.4e}) at {:.6g}. std {:.2f} ns, fast {:.2f} ns.\n",
+    passed ? "PASS" : "FAIL", name, kind == ErrorKind::absolute ? "abs" : "rel", maxError, bound,
+    worstInput, refNs, approxNs);
+  return passed;
+}
+
+// `float` is tested with a bound of a few ulp, as the polynomials are more accurate than `float`.
+bool testFloat() {
+  float maxError = 0;
+  for (size_t i = 0; i < nSample; ++i) {
+    const float x = -30.0f + 60.0f * float(i) / float(nSample - 1);
+    const float ref = float(std::exp2(double(x)));
+    maxError = std::max(maxError, std::abs(FastMath::exp2(x) - ref) / ref);
+  }
+  const float bound = 4 * std::numeric_limits<float>::epsilon();
+  const bool passed = maxError <= bound;
+  std::cout << std::format("{} exp2 float       rel error {:.3e} (bound {:.1e}).\n",
+                           passed ? "PASS" : "FAIL", maxError, bound);
+  return passed;
+}
+
+} // namespace
+
+// Lambdas are used instead of function pointers, so that timing includes inlining.
+#define UHHYOU_UNARY(fn) [](double x, double) { return fn(x); }
+
+int main() {
+  constexpr auto abs = ErrorKind::absolute;
+  constexpr auto rel = ErrorKind::relative;
+
+  /*
+  Approximation errors are written in `fastmath.hpp`. They are properties of the polynomials, so
+  they don't change with platform. Rounding in `double` varies with FMA contraction, compiler, and
+  libm used as reference, but it's in the order of ulp. `headroom` is far larger than that, and
+  far smaller than the approximation errors.
+  */
+  constexpr double eps = std::numeric_limits<double>::epsilon();
+  constexpr double headroom = 256 * eps;
+
+  constexpr double exp2Error = 4.03e-11;
+  constexpr double expScaling = 6.91 * eps / 2; // `|x| * eps / 2` for rounding of `x * log2(e)`.
+  constexpr double erfError = 1.83e-10 + 0.158 * exp2Error; // `0.158 > erfc(1)`.
+  constexpr double tanCMin = 0.01 * pi; // Minimum of `pi/2 - |x|` in the tested range.
+  constexpr double cosReduction = 3 * pi * eps;
+
+  bool passed = true;
+  passed &= runCase("exp2 [-16, 16]", rel, exp2Error + headroom, linspace(-16, 16),
+                    UHHYOU_UNARY(std::exp2), UHHYOU_UNARY(FastMath::exp2));
+  passed &= runCase("exp2 [-1000, 1000]", rel, exp2Error + headroom, linspace(-1000, 1000),
+                    UHHYOU_UNARY(std::exp2), UHHYOU_UNARY(FastMath::exp2));
+  passed &= runCase("exp [-6.91, 0]", rel, exp2Error + expScaling + headroom,
+                    linspace(-6.907755278982137, 0), UHHYOU_UNARY(std::exp),
+                    UHHYOU_UNARY(FastMath::exp));
+  passed &= runCase("erf [-16, 16]", abs, erfError + headroom, linspace(-16, 16),
+                    UHHYOU_UNARY(std::erf), UHHYOU_UNARY(FastMath::erf));
+  passed &= runCase("erf (-1, 1)", rel, 3.33e-11 + headroom, linspace(-0.999999, 0.999999),
+                    UHHYOU_UNARY(std::erf), UHHYOU_UNARY(FastMath::erf));
+  passed &= runCase("tan (0, pi/2)", rel, 4.1e-11 + eps / tanCMin + headroom,
+                    linspace(1e-5 * pi, 0.49 * pi), UHHYOU_UNARY(std::tan),
+                    UHHYOU_UNARY(FastMath::tan));
+  passed &= runCase("cos [-pi, 3pi]", abs, 2.12e-11 + cosReduction + headroom,
+                    linspace(-pi, 3 * pi), UHHYOU_UNARY(std::cos), UHHYOU_UNARY(FastMath::cos));
+  passed &= runCase(
+    "atan2", abs, 8.13e-12 + pi * headroom, circle(),
+    [](double y, double x) { return std::atan2(y, x); },
+    [](double y, double x) { return FastMath::atan2(y, x); });
+  passed &= testFloat();
+  return passed ? 0 : 1;
+}
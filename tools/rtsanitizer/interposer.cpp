@@ -0,0 +1,397 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+// Fortified headers turn some of the hooked functions into inline wrappers, and the definitions
+// below become redefinitions.
+#undef _FORTIFY_SOURCE
+
+#include "interposer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__) && defined(__GLIBC__)
+#define UHHYOU_RTSAN_C_HOOKS 1
+
+#include <cstdarg>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/select.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Uhhyou::RtSanitizer::Violation;
+
+constexpr size_t nViolation = size_t(Violation::size);
+constexpr int maxFrame = 48;
+
+struct FirstViolation {
+  std::atomic<bool> isTaken{false};
+  const char* function = nullptr;
+  int depth = 0;
+  std::array<void*, maxFrame> frames{};
+};
+
+// Hooks may run before dynamic initialization, so these must be constant initialized.
+std::array<std::atomic<uint64_t>, nViolation> counts{};
+std::array<FirstViolation, nViolation> firsts{};
+
+thread_local bool isRealtime = false;
+thread_local bool isInHook = false;
+
+void record(Violation kind, const char* function) {
+  if (!isRealtime || isInHook) { return; }
+  isInHook = true;
+
+  const auto index = size_t(kind);
+  counts[index].fetch_add(1, std::memory_order_relaxed);
+
+  auto& first = firsts[index];
+  if (!first.isTaken.exchange(true, std::memory_order_acq_rel)) {
+    first.function = function;
+#ifdef UHHYOU_RTSAN_C_HOOKS
+    first.depth = backtrace(first.frames.data(), maxFrame);
+#endif
+  }
+
+  isInHook = false;
+}
+
+} // namespace
+
+namespace Uhhyou::RtSanitizer {
+
+ScopedRealtime::ScopedRealtime() { isRealtime = true; }
+ScopedRealtime::~ScopedRealtime() { isRealtime = false; }
+
+uint64_t getViolationCount() {
+  uint64_t sum = 0;
+  for (const auto& c : counts) { sum += c.load(std::memory_order_relaxed); }
+  return sum;
+}
+
+void clear() {
+  for (auto& c : counts) { c.store(0, std::memory_order_relaxed); }
+  for (auto& f : firsts) {
+    f.function = nullptr;
+    f.depth = 0;
+    f.isTaken.store(false, std::memory_order_release);
+  }
+}
+
+void printReport(std::ostream& os) {
+  constexpr std::array<const char*, nViolation> names{
+    "allocation", "deallocation", "lock", "blocking call"};
+
+  for (size_t i = 0; i < nViolation; ++i) {
+    const auto count = counts[i].load(std::memory_order_relaxed);
+    if (count == 0) { continue; }
+
+    const auto& first = firsts[i];
+    os << "  " << names[i] << ": " << count << " time(s). First call is "
+       << (first.function == nullptr ? "unknown" : first.function) << ".\n";
+
+#ifdef UHHYOU_RTSAN_C_HOOKS
+    os.flush();
+    backtrace_symbols_fd(first.frames.data(), first.depth, STDOUT_FILENO);
+#endif
+  }
+  clear();
+}
+
+} // namespace Uhhyou::RtSanitizer
+
+#ifdef UHHYOU_RTSAN_C_HOOKS
+
+// glibc exports the allocator under these names, so `malloc` can be hooked without `dlsym`.
+// `dlsym` itself may call `calloc`.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+void* __libc_memalign(size_t alignment, size_t size);
+}
+
+// Function-local static can't be used to cache the pointer. Its guard may take a lock, and
+// that lock is hooked.
+#define UHHYOU_RTSAN_BLOCKING_FUNCTIONS(X)                                                         \
+  X(pthread_mutex_lock)                                                                            \
+  X(pthread_rwlock_rdlock)                                                                         \
+  X(pthread_rwlock_wrlock)                                                                         \
+  X(pthread_cond_wait)                                                                             \
+  X(pthread_cond_timedwait)                                                                        \
+  X(pthread_join)                                                                                  \
+  X(sem_wait)                                                                                      \
+  X(nanosleep)                                                                                     \
+  X(clock_nanosleep)                                                                               \
+  X(usleep)                                                                                        \
+  X(sleep)                                                                                         \
+  X(sched_yield)                                                                                   \
+  X(read)                                                                                          \
+  X(write)                                                                                         \
+  X(open)                                                                                          \
+  X(openat)                                                                                        \
+  X(close)                                                                                         \
+  X(poll)                                                                                          \
+    X(select)
+
+namespace {
+
+#define X(name) std::atomic<void*> real_##name{nullptr};
+UHHYOU_RTSAN_BLOCKING_FUNCTIONS(X)
+#undef X
+
+void* resolve(std::atomic<void*>& slot, const char* name) {
+  void* ptr = slot.load(std::memory_order_relaxed);
+  if (ptr == nullptr) {
+    ptr = dlsym(RTLD_NEXT, name);
+    slot.store(ptr, std::memory_order_relaxed);
+  }
+  return ptr;
+}
+
+} // namespace
+
+#define UHHYOU_RTSAN_REAL(name) (reinterpret_cast<decltype(&::name)>(resolve(real_##name, #name)))
+
+namespace Uhhyou::RtSanitizer {
+
+bool hasCHooks() { return true; }
+
+void initialize() {
+#define X(name) resolve(real_##name, #name);
+  UHHYOU_RTSAN_BLOCKING_FUNCTIONS(X)
+#undef X
+
+  // The first call of `backtrace` loads libgcc, which allocates.
+  std::array<void*, maxFrame> frames{};
+  backtrace(frames.data(), maxFrame);
+}
+
+} // namespace Uhhyou::RtSanitizer
+
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+  record(Violation::allocation, "malloc");
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+  record(Violation::allocation, "calloc");
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  record(Violation::allocation, "realloc");
+  return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept {
+  if (ptr != nullptr) { record(Violation::deallocation, "free"); }
+  __libc_free(ptr);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+  record(Violation::allocation, "aligned_alloc");
+  return __libc_memalign(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+  record(Violation::allocation, "memalign");
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept {
+  record(Violation::allocation, "posix_memalign");
+  if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) { return EINVAL; }
+  void* p = __libc_memalign(alignment, size);
+  if (p == nullptr) { return ENOMEM; }
+  *ptr = p;
+  return 0;
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept {
+  record(Violation::lock, "pthread_mutex_lock");
+  return UHHYOU_RTSAN_REAL(pthread_mutex_lock)(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept {
+  record(Violation::lock, "pthread_rwlock_rdlock");
+  return UHHYOU_RTSAN_REAL(pthread_rwlock_rdlock)(lock);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept {
+  record(Violation::lock, "pthread_rwlock_wrlock");
+  return UHHYOU_RTSAN_REAL(pthread_rwlock_wrlock)(lock);
+}
+
+int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) {
+  record(Violation::lock, "pthread_cond_wait");
+  return UHHYOU_RTSAN_REAL(pthread_cond_wait)(cond, mutex);
+}
+
+int pthread_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex,
+                           const struct timespec* time) {
+  record(Violation::lock, "pthread_cond_timedwait");
+  return UHHYOU_RTSAN_REAL(pthread_cond_timedwait)(cond, mutex, time);
+}
+
+int pthread_join(pthread_t thread, void** result) {
+  record(Violation::lock, "pthread_join");
+  return UHHYOU_RTSAN_REAL(pthread_join)(thread, result);
+}
+
+int sem_wait(sem_t* sem) {
+  record(Violation::lock, "sem_wait");
+  return UHHYOU_RTSAN_REAL(sem_wait)(sem);
+}
+
+int nanosleep(const struct timespec* duration, struct timespec* remaining) {
+  record(Violation::blockingCall, "nanosleep");
+  return UHHYOU_RTSAN_REAL(nanosleep)(duration, remaining);
+}
+
+int clock_nanosleep(clockid_t clock, int flags, const struct timespec* time,
+                    struct timespec* remaining) {
+  record(Violation::blockingCall, "clock_nanosleep");
+  return UHHYOU_RTSAN_REAL(clock_nanosleep)(clock, flags, time, remaining);
+}
+
+int usleep(useconds_t microseconds) {
+  record(Violation::blockingCall, "usleep");
+  return UHHYOU_RTSAN_REAL(usleep)(microseconds);
+}
+
+unsigned int sleep(unsigned int seconds) {
+  record(Violation::blockingCall, "sleep");
+  return UHHYOU_RTSAN_REAL(sleep)(seconds);
+}
+
+int sched_yield() noexcept {
+  record(Violation::blockingCall, "sched_yield");
+  return UHHYOU_RTSAN_REAL(sched_yield)();
+}
+
+ssize_t read(int fd, void* buffer, size_t size) {
+  record(Violation::blockingCall, "read");
+  return UHHYOU_RTSAN_REAL(read)(fd, buffer, size);
+}
+
+ssize_t write(int fd, const void* buffer, size_t size) {
+  record(Violation::blockingCall, "write");
+  return UHHYOU_RTSAN_REAL(write)(fd, buffer, size);
+}
+
+int open(const char* path, int flags, ...) {
+  mode_t mode = 0;
+  if (flags & (O_CREAT | O_TMPFILE)) {
+    va_list args;
+    va_start(args, flags);
+    mode = va_arg(args, mode_t);
+    va_end(args);
+  }
+  record(Violation::blockingCall, "open");
+  return UHHYOU_RTSAN_REAL(open)(path, flags, mode);
+}
+
+int openat(int dirfd, const char* path, int flags, ...) {
+  mode_t mode = 0;
+  if (flags & (O_CREAT | O_TMPFILE)) {
+    va_list args;
+    va_start(args, flags);
+    mode = va_arg(args, mode_t);
+    va_end(args);
+  }
+  record(Violation::blockingCall, "openat");
+  return UHHYOU_RTSAN_REAL(openat)(dirfd, path, flags, mode);
+}
+
+int close(int fd) {
+  record(Violation::blockingCall, "close");
+  return UHHYOU_RTSAN_REAL(close)(fd);
+}
+
+int poll(struct pollfd* fds, nfds_t nfds, int timeout) {
+  record(Violation::blockingCall, "poll");
+  return UHHYOU_RTSAN_REAL(poll)(fds, nfds, timeout);
+}
+
+int select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds,
+           struct timeval* timeout) {
+  record(Violation::blockingCall, "select");
+  return UHHYOU_RTSAN_REAL(select)(nfds, readfds, writefds, exceptfds, timeout);
+}
+
+} // extern "C"
+
+#else // UHHYOU_RTSAN_C_HOOKS
+
+// Only allocations through `operator new` and `operator delete` are caught on this platform.
+
+namespace Uhhyou::RtSanitizer {
+
+bool hasCHooks() { return false; }
+void initialize() {}
+
+} // namespace Uhhyou::RtSanitizer
+
+namespace {
+
+void* allocate(std::size_t size, const char* function) {
+  record(Violation::allocation, function);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void deallocate(void* ptr, const char* function) {
+  if (ptr != nullptr) { record(Violation::deallocation, function); }
+  std::free(ptr);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+  if (auto ptr = allocate(size, "operator new")) { return ptr; }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  if (auto ptr = allocate(size, "operator new[]")) { return ptr; }
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size, "operator new");
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size, "operator new[]");
+}
+
+void operator delete(void* ptr) noexcept { deallocate(ptr, "operator delete"); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr, "operator delete[]"); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr, "operator delete"); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr, "operator delete[]"); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  deallocate(ptr, "operator delete");
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  deallocate(ptr, "operator delete[]");
+}
+
+#endif // UHHYOU_RTSAN_C_HOOKS
@@ -0,0 +1,41 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+namespace Uhhyou::RtSanitizer {
+
+enum class Violation : uint8_t { allocation, deallocation, lock, blockingCall, size };
+
+/**
+Marks the current thread as real-time while alive. Hooked functions called on this thread are
+recorded as violations. Nesting is not supported.
+*/
+class ScopedRealtime {
+public:
+  ScopedRealtime();
+  ~ScopedRealtime();
+
+  ScopedRealtime(const ScopedRealtime&) = delete;
+  ScopedRealtime& operator=(const ScopedRealtime&) = delete;
+};
+
+// Resolves hooked functions and warms up backtrace. Call once before any `ScopedRealtime`.
+void initialize();
+
+// True if C library functions are hooked. Otherwise, only `operator new` and `operator delete`
+// are hooked.
+bool hasCHooks();
+
+uint64_t getViolationCount();
+
+// Prints counts and the first backtrace of each violation, then clears them. Don't call while a
+// `ScopedRealtime` is alive on other thread.
+void printReport(std::ostream& os);
+
+void clear();
+
+} // namespace Uhhyou::RtSanitizer
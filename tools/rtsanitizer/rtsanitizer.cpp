@@ -0,0 +1,239 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/*
+Real-time safety test of `Processor::processBlock`.
+
+`processBlock` runs on an audio thread marked by `RtSanitizer::ScopedRealtime`. Allocations, lock
+waits and blocking calls made inside are reported with a backtrace. See `interposer.cpp` for the
+hooked functions.
+
+Scenarios:
+
+- `sweep`: All parameters are changed before each block, in the same way as the VST3 wrapper of
+  JUCE. Block size varies.
+- `midi`: Each block has many MIDI events. Notes are held until all channels and note numbers are
+  used, then released.
+- `state`: Message thread loads states with `setStateInformation` while the audio thread runs.
+
+Usage:
+
+```
+rtsanitizer_<Plugin> [--blocks <n>] [--block-size <n>]
+```
+
+Exit code is 0 when no violation is found.
+*/
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include "interposer.hpp"
+#include "PluginProcessor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace RtSanitizer = Uhhyou::RtSanitizer;
+
+constexpr double sampleRate = 48000.0;
+
+struct Options {
+  int nBlock = 2000;
+  int maxBlockSize = 512;
+};
+
+// Everything used on the audio thread is allocated here, before the test starts.
+struct AudioThreadData {
+  juce::AudioBuffer<float> buffer;
+  std::vector<juce::MidiBuffer> midi;
+  std::vector<int> blockSizes;
+  std::vector<juce::AudioProcessorParameter*> parameters;
+  bool isSweepingParameter = false;
+};
+
+void fillNoise(juce::AudioBuffer<float>& buffer, juce::Random& rng) {
+  for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+    auto dest = buffer.getWritePointer(ch);
+    for (int i = 0; i < buffer.getNumSamples(); ++i) { dest[i] = rng.nextFloat() - 0.5f; }
+  }
+}
+
+// Note-ons are sent until all 16 channels and 128 notes are held, then note-offs follow. Pitch
+// bends are mixed in.
+std::vector<juce::MidiBuffer> makeMidiFlood(int nBlock, int maxBlockSize) {
+  constexpr int nEventPerBlock = 64;
+  constexpr int nNote = 16 * 128;
+
+  std::vector<juce::MidiBuffer> blocks(size_t(nBlock));
+  int noteIndex = 0;
+  bool isNoteOn = true;
+  for (int b = 0; b < nBlock; ++b) {
+    auto& midi = blocks[size_t(b)];
+    midi.ensureSize(size_t(nEventPerBlock) * 16);
+    for (int e = 0; e < nEventPerBlock; ++e) {
+      const int position = e * maxBlockSize / nEventPerBlock;
+      const int channel = noteIndex / 128 + 1;
+      const int note = noteIndex % 128;
+      if (isNoteOn) {
+        midi.addEvent(juce::MidiMessage::noteOn(channel, note, juce::uint8(100)), position);
+      } else {
+        midi.addEvent(juce::MidiMessage::noteOff(channel, note), position);
+      }
+      if (e % 8 == 0) {
+        midi.addEvent(juce::MidiMessage::pitchWheel(channel, (b * 97 + e) % 0x4000), position);
+      }
+
+      if (++noteIndex >= nNote) {
+        noteIndex = 0;
+        isNoteOn = !isNoteOn;
+      }
+    }
+  }
+  return blocks;
+}
+
+std::vector<juce::MemoryBlock> makeStates(Processor& processor, int nState) {
+  juce::Random rng(1);
+  std::vector<juce::MemoryBlock> states(size_t(nState));
+  for (auto& state : states) {
+    for (auto prm : processor.getParameters()) { prm->setValueNotifyingHost(rng.nextFloat()); }
+    processor.getStateInformation(state);
+  }
+  return states;
+}
+
+// Runs on the audio thread.
+void runAudioThread(Processor& processor, AudioThreadData& data, std::atomic<bool>& isDone) {
+  juce::Random rng(2);
+  auto& buffer = data.buffer;
+  for (size_t b = 0; b < data.blockSizes.size(); ++b) {
+    const int length = data.blockSizes[b];
+    juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                   length);
+    auto& midi = data.midi[b % data.midi.size()];
+
+    const float value = rng.nextFloat();
+    {
+      RtSanitizer::ScopedRealtime realtime;
+
+      if (data.isSweepingParameter) {
+        for (auto prm : data.parameters) {
+          prm->setValue(value);
+          prm->sendValueChangedMessageToListeners(value);
+        }
+      }
+
+      processor.processBlock(block, midi);
+    }
+  }
+  isDone.store(true);
+}
+
+bool runScenario(const std::string& name, Processor& processor, AudioThreadData& data,
+                 const std::function<void()>& onMessageThread) {
+  processor.prepareToPlay(sampleRate, data.buffer.getNumSamples());
+  RtSanitizer::clear();
+
+  std::atomic<bool> isDone{false};
+  std::thread audioThread([&]() { runAudioThread(processor, data, isDone); });
+  while (!isDone.load()) {
+    if (onMessageThread) {
+      onMessageThread();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  audioThread.join();
+
+  const auto nViolation = RtSanitizer::getViolationCount();
+  if (nViolation == 0) {
+    std::cout << std::format("PASS {}\n", name);
+    return true;
+  }
+  std::cout << std::format("FAIL {}: {} violation(s).\n", name, nViolation);
+  RtSanitizer::printReport(std::cout);
+  return false;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  RtSanitizer::initialize();
+
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    if (arg == "--blocks" && i + 1 < argc) {
+      opt.nBlock = std::max(std::atoi(argv[++i]), 1);
+    } else if (arg == "--block-size" && i + 1 < argc) {
+      opt.maxBlockSize = std::max(std::atoi(argv[++i]), 1);
+    } else {
+      std::cerr << std::format("Usage: {} [--blocks <n>] [--block-size <n>]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (!RtSanitizer::hasCHooks()) {
+    std::cout << "Only `operator new` and `operator delete` are checked on this platform.\n";
+  }
+
+  auto processor = std::make_unique<Processor>();
+  processor->enableAllBuses();
+
+  juce::Random rng(0);
+  AudioThreadData data;
+  const int nChannel
+    = std::max(processor->getTotalNumInputChannels(), processor->getTotalNumOutputChannels());
+  data.buffer.setSize(nChannel, opt.maxBlockSize);
+  fillNoise(data.buffer, rng);
+  data.midi.resize(1);
+  data.midi[0].ensureSize(1024);
+  for (int b = 0; b < opt.nBlock; ++b) {
+    // Mostly full blocks, and sometimes short ones as some hosts do around loop points.
+    data.blockSizes.push_back(b % 7 == 0 ? rng.nextInt({1, opt.maxBlockSize + 1})
+                                         : opt.maxBlockSize);
+  }
+  for (auto prm : processor->getParameters()) { data.parameters.push_back(prm); }
+
+  bool passed = true;
+
+  data.isSweepingParameter = true;
+  passed &= runScenario("sweep", *processor, data, nullptr);
+  data.isSweepingParameter = false;
+
+  if (processor->acceptsMidi()) {
+    // ShockFlanger ignores notes unless this is on.
+    if (auto prm = processor->param.tree.getParameter("noteReceive")) {
+      prm->setValueNotifyingHost(1.0f);
+    }
+    data.midi = makeMidiFlood(opt.nBlock, opt.maxBlockSize);
+    passed &= runScenario("midi", *processor, data, nullptr);
+    data.midi.resize(1);
+    data.midi[0].clear();
+  }
+
+  const auto states = makeStates(*processor, 16);
+  size_t stateIndex = 0;
+  passed &= runScenario("state", *processor, data, [&]() {
+    const auto& state = states[stateIndex];
+    processor->setStateInformation(state.getData(), int(state.getSize()));
+    stateIndex = (stateIndex + 1) % states.size();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/*
+Cost and aliasing benchmark for `Saturator<Real>::Function` in ShockFlanger.
+
+For each saturator function and drive level, this program measures:
+
+- Time per sample (ns, and CPU cycles on x86-64).
+- Aliasing-to-signal ratio (ASR). A coherently sampled sine is rendered at 1x. Power at the bins of
+  the in-band harmonics is signal, and power at the other bins is aliasing. The signal power is
+  taken from a reference rendered at `upFold` times oversampling, so the ratio is relative to the
+  ideal band-limited output.
+- Harmonic droop. Power of in-band harmonics at 1x relative to the reference. ADAA trades aliasing
+  for high frequency loss, and this column shows the loss.
+
+Output is CSV. `pareto` is 1 when no other function at the same drive is both faster and has lower
+ASR.
+*/
+
+#include "../../plugins/ShockFlanger/dsp/saturator.hpp"
+
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #else
+    #include <x86intrin.h>
+  #endif
+  #define UHHYOU_HAS_RDTSC 1
+#endif
+
+using Real = double;
+using Saturator = Uhhyou::Saturator<Real>;
+using Function = Saturator::Function;
+
+constexpr size_t nFft = size_t(1) << 14;
+constexpr size_t upFold = 64;
+constexpr size_t sineBin = 3001; // Prime, so aliased harmonics rarely land on in-band harmonics.
+constexpr size_t nTimingRepeat = 16;
+
+const std::vector<Real> driveDecibels{Real(-12), Real(0), Real(12), Real(24)};
+
+struct FunctionInfo {
+  const char* name;
+  Function fn;
+};
+
+const std::vector<FunctionInfo> functions{
+#define X(name) {#name, Function::name},
+  UHHYOU_SATURATOR_FUNCTIONS(X)
+#undef X
+};
+
+struct Result {
+  std::string name;
+  Real driveDecibel = 0;
+  Real nsPerSample = 0;
+  Real cyclesPerSample = 0;
+  Real asrDecibel = 0;
+  Real droopDecibel = 0;
+  bool isFinite = true;
+  bool isPareto = false;
+};
+
+// In-place iterative radix-2 FFT. `x.size()` must be power of 2.
+void fft(std::vector<std::complex<Real>>& x) {
+  const size_t n = x.size();
+  for (size_t i = 1, j = 0; i < n; ++i) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) { j ^= bit; }
+    j ^= bit;
+    if (i < j) { std::swap(x[i], x[j]); }
+  }
+  for (size_t len = 2; len <= n; len <<= 1) {
+    const Real theta = Real(-2) * std::numbers::pi_v<Real> / Real(len);
+    const std::complex<Real> wlen{std::cos(theta), std::sin(theta)};
+    for (size_t i = 0; i < n; i += len) {
+      std::complex<Real> w{Real(1), Real(0)};
+      for (size_t k = 0; k < len / 2; ++k) {
+        const auto u = x[i + k];
+        const auto v = x[i + k + len / 2] * w;
+        x[i + k] = u + v;
+        x[i + k + len / 2] = u - v;
+        w *= wlen;
+      }
+    }
+  }
+}
+
+// Returns one period of output after one period of warm up.
+std::vector<Real> render(Function fn, Real amplitude, size_t fold) {
+  const size_t length = nFft * fold;
+  const Real omega
+    = Real(2) * std::numbers::pi_v<Real> * Real(sineBin) / Real(length);
+
+  Saturator saturator;
+  saturator.reset();
+  std::vector<Real> output(length);
+  for (size_t pass = 0; pass < 2; ++pass) {
+    for (size_t i = 0; i < length; ++i) {
+      output[i] = saturator.process(amplitude * std::sin(omega * Real(i)), fn);
+    }
+  }
+  return output;
+}
+
+// Power spectrum of bins in [0, nFft / 2]. Normalized by the FFT length.
+std::vector<Real> powerSpectrum(const std::vector<Real>& signal) {
+  std::vector<std::complex<Real>> spec(signal.begin(), signal.end());
+  fft(spec);
+
+  const Real norm = Real(1) / Real(signal.size());
+  std::vector<Real> power(nFft / 2 + 1);
+  for (size_t k = 0; k < power.size(); ++k) { power[k] = std::norm(spec[k] * norm); }
+  return power;
+}
+
+bool isHarmonicBin(size_t bin) { return bin % sineBin == 0; }
+
+void measureAliasing(Result& result, Function fn, Real amplitude) {
+  const auto base = powerSpectrum(render(fn, amplitude, 1));
+  const auto reference = powerSpectrum(render(fn, amplitude, upFold));
+
+  Real signal = 0;
+  Real alias = 0;
+  Real signalReference = 0;
+  // Bin 0 is skipped. DC from asymmetric functions like halfrect is neither harmonic nor aliasing.
+  for (size_t k = 1; k < base.size(); ++k) {
+    if (isHarmonicBin(k)) {
+      signal += base[k];
+      signalReference += reference[k];
+    } else {
+      alias += base[k];
+    }
+  }
+
+  result.isFinite = std::isfinite(signal) && std::isfinite(alias) && std::isfinite(signalReference)
+    && signalReference > 0;
+  if (!result.isFinite) { return; }
+
+  constexpr Real tiny = std::numeric_limits<Real>::min();
+  result.asrDecibel = Real(10) * std::log10(std::max(alias, tiny) / signalReference);
+  result.droopDecibel = Real(10) * std::log10(std::max(signal, tiny) / signalReference);
+}
+
+void measureCost(Result& result, Function fn, Real amplitude) {
+  const Real omega = Real(2) * std::numbers::pi_v<Real> * Real(sineBin) / Real(nFft);
+  std::vector<Real> input(nFft);
+  for (size_t i = 0; i < nFft; ++i) { input[i] = amplitude * std::sin(omega * Real(i)); }
+
+  Saturator saturator;
+  saturator.reset();
+  Real sum = 0;
+
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+#ifdef UHHYOU_HAS_RDTSC
+  const auto startCycle = __rdtsc();
+#endif
+  for (size_t rep = 0; rep < nTimingRepeat; ++rep) {
+    for (const auto& x : input) { sum += saturator.process(x, fn); }
+  }
+#ifdef UHHYOU_HAS_RDTSC
+  const auto endCycle = __rdtsc();
+#endif
+  const auto end = Clock::now();
+
+  // Prevents the loop from being optimized out.
+  volatile Real sink = sum;
+  (void)sink;
+
+  const Real nSample = Real(nTimingRepeat * nFft);
+  result.nsPerSample
+    = Real(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / nSample;
+#ifdef UHHYOU_HAS_RDTSC
+  result.cyclesPerSample = Real(endCycle - startCycle) / nSample;
+#else
+  result.cyclesPerSample = std::numeric_limits<Real>::quiet_NaN();
+#endif
+}
+
+void markPareto(std::vector<Result>& results) {
+  for (auto& a : results) {
+    if (!a.isFinite) { continue; }
+    a.isPareto = true;
+    for (const auto& b : results) {
+      if (&a == &b || !b.isFinite || a.driveDecibel != b.driveDecibel) { continue; }
+      const bool dominated = b.nsPerSample <= a.nsPerSample && b.asrDecibel <= a.asrDecibel
+        && (b.nsPerSample < a.nsPerSample || b.asrDecibel < a.asrDecibel);
+      if (dominated) {
+        a.isPareto = false;
+        break;
+      }
+    }
+  }
+}
+
+int main() {
+  std::vector<Result> results;
+  for (const auto& drive : driveDecibels) {
+    const Real amplitude = std::pow(Real(10), drive / Real(20));
+    for (const auto& info : functions) {
+      Result result;
+      result.name = info.name;
+      result.driveDecibel = drive;
+      measureCost(result, info.fn, amplitude);
+      measureAliasing(result, info.fn, amplitude);
+      results.push_back(result);
+
+      std::cerr << std::format("Done: {} at {} dB\n", info.name, drive);
+    }
+  }
+  markPareto(results);
+
+  std::cout << "function,driveDecibel,nsPerSample,cyclesPerSample,asrDecibel,droopDecibel,pareto\n";
+  for (const auto& r : results) {
+    if (r.isFinite) {
+      std::cout << std::format("{},{},{:.3f},{:.1f},{:.2f},{:.3f},{}\n", r.name, r.driveDecibel,
+                               r.nsPerSample, r.cyclesPerSample, r.asrDecibel, r.droopDecibel,
+                               int(r.isPareto));
+    } else {
+      std::cout << std::format("{},{},{:.3f},{:.1f},nan,nan,0\n", r.name, r.driveDecibel,
+                               r.nsPerSample, r.cyclesPerSample);
+    }
+  }
+  return 0;
+}
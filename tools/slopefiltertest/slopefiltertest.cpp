@@ -0,0 +1,240 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/*
+Equivalence test of `SlopeFilter` and `SlopeFilterParallel` in SlopeFilter plugin.
+
+Magnitude responses of both forms are computed from coefficients and compared over a grid of
+parameters. Outputs for white noise are also compared, because the parallel form cancels large
+terms when poles are close to 1. Time per sample is printed for reference, but it's not tested.
+
+Exit code is 0 when all errors are within bounds.
+*/
+
+#include "dsp/filter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <format>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Uhhyou::SlopeFilter;
+using Uhhyou::SlopeFilterParallel;
+
+constexpr size_t nCascade = 12;
+constexpr double sampleRate = 48000;
+
+using Cascade = SlopeFilter<double, nCascade>;
+using Parallel = SlopeFilterParallel<double, nCascade>;
+
+struct Parameter {
+  double startHz;
+  double slopeDecibel;
+  bool isHighshelf;
+};
+
+// Start frequencies avoid `10 * 2^n` Hz. Cutoffs then land exactly on the lower limit of
+// `matchedHighShelf1`, and the clamping may differ between 2 forms by rounding of `-ffast-math`.
+std::vector<Parameter> parameterGrid() {
+  std::vector<Parameter> grid;
+  for (double startHz : {13.0, 37.0, 150.0, 1100.0, 5100.0, 19000.0}) {
+    for (double slopeDecibel : {-20.0, -6.0, -0.1, 0.0, 0.1, 3.0, 20.0}) {
+      for (bool isHighshelf : {false, true}) {
+        grid.push_back({startHz, slopeDecibel, isHighshelf});
+      }
+    }
+  }
+  return grid;
+}
+
+std::string toString(const Parameter& p) {
+  return std::format("{} Hz, {} dB/oct, {}", p.startHz, p.slopeDecibel,
+                     p.isHighshelf ? "high shelf" : "low shelf");
+}
+
+// Difference is in decibel, and only checked where the response is within 120 dB from the peak.
+bool testMagnitudeResponse(const std::vector<Parameter>& grid) {
+  using C = std::complex<double>;
+  constexpr size_t nFrequency = 4096;
+  constexpr double bound = 1e-5;
+
+  double maxError = 0;
+  Parameter worst{};
+  for (const auto& p : grid) {
+    Cascade::Coefficient cascade;
+    Parallel::Coefficient parallel;
+    cascade.reset(sampleRate, p.startHz, p.slopeDecibel, 1, p.isHighshelf);
+    parallel.reset(sampleRate, p.startHz, p.slopeDecibel, 1, p.isHighshelf);
+
+    std::vector<double> hc(nFrequency);
+    std::vector<double> hp(nFrequency);
+    for (size_t k = 0; k < nFrequency; ++k) {
+      const double freq = std::pow(0.5 / 1e-4, double(k) / double(nFrequency - 1)) * 1e-4;
+      const C z1 = std::polar(1.0, -2 * std::numbers::pi * freq); // z^-1.
+
+      C cascadeResponse = cascade.b0[nCascade];
+      for (size_t i = 0; i < nCascade; ++i) {
+        cascadeResponse *= (cascade.b0[i] + cascade.b1[i] * z1) / (1.0 - cascade.na1[i] * z1);
+      }
+      C parallelResponse = 0;
+      for (size_t i = 0; i < Parallel::Coefficient::nLane; ++i) {
+        parallelResponse += parallel.residue[i] / (1.0 - parallel.pole[i] * z1);
+      }
+      hc[k] = std::abs(cascadeResponse);
+      hp[k] = std::abs(parallelResponse);
+    }
+
+    const double floor = 1e-6 * *std::max_element(hc.begin(), hc.end());
+    for (size_t k = 0; k < nFrequency; ++k) {
+      if (hc[k] < floor) { continue; }
+      const double error = std::abs(20 * std::log10(hp[k] / hc[k]));
+      if (!(error <= maxError)) {
+        maxError = error;
+        worst = p;
+      }
+    }
+  }
+
+  const bool passed = maxError <= bound;
+  std::cout << std::format("{} magnitude response error {:.3e} dB (bound {:.1e}) at {}.\n",
+                           passed ? "PASS" : "FAIL", maxError, bound, toString(worst));
+  return passed;
+}
+
+// Error is relative to the larger of input and output, as some outputs are far below the input.
+bool testNoiseResponse(const std::vector<Parameter>& grid) {
+  constexpr size_t length = 65536;
+  constexpr double bound = -200;
+
+  std::mt19937_64 rng(0);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> input(length);
+  for (auto& x : input) { x = dist(rng); }
+
+  double maxError = -1000;
+  Parameter worst{};
+  for (const auto& p : grid) {
+    Cascade::Coefficient cascadeCo;
+    Parallel::Coefficient parallelCo;
+    cascadeCo.reset(sampleRate, p.startHz, p.slopeDecibel, 1, p.isHighshelf);
+    parallelCo.reset(sampleRate, p.startHz, p.slopeDecibel, 1, p.isHighshelf);
+
+    Cascade cascade;
+    Parallel parallel;
+    cascade.reset();
+    parallel.reset();
+
+    double errorPower = 0;
+    double signalPower = 0;
+    for (const auto& x : input) {
+      const double yc = cascade.process(x, cascadeCo);
+      const double yp = parallel.process(x, parallelCo);
+      errorPower += (yp - yc) * (yp - yc);
+      signalPower += std::max(yc * yc, x * x);
+    }
+
+    const double error = errorPower > 0 ? 10 * std::log10(errorPower / signalPower) : -1000;
+    if (error > maxError) {
+      maxError = error;
+      worst = p;
+    }
+  }
+
+  const bool passed = maxError <= bound;
+  std::cout << std::format("{} noise response error {:.1f} dB (bound {:.1f}) at {}.\n",
+                           passed ? "PASS" : "FAIL", maxError, bound, toString(worst));
+  return passed;
+}
+
+// Smoothing must stop within 2 seconds after a change of parameters.
+template<typename Coefficient>
+bool testConvergence(const char* name, const Parameter& from, double fromGain, const Parameter& to,
+                     double toGain) {
+  constexpr size_t blockSize = 256;
+  constexpr size_t maxBlock = size_t(2 * sampleRate) / blockSize;
+
+  Coefficient co;
+  co.reset(sampleRate, from.startHz, from.slopeDecibel, fromGain, from.isHighshelf);
+  co.push(sampleRate, to.startHz, to.slopeDecibel, toGain, to.isHighshelf);
+
+  size_t nBlock = 0;
+  while (co.isSmoothing() && nBlock < maxBlock) {
+    for (size_t i = 0; i < blockSize; ++i) { co.process(); }
+    co.updateConvergence();
+    ++nBlock;
+  }
+
+  const bool passed = !co.isSmoothing();
+  std::cout << std::format("{} {} convergence in {} blocks of {} samples. To {}, gain {}.\n",
+                           passed ? "PASS" : "FAIL", name, nBlock, blockSize, toString(to),
+                           toGain);
+  return passed;
+}
+
+bool testConvergence() {
+  bool passed = true;
+
+  // Largest change of parameters.
+  passed &= testConvergence<Cascade::Coefficient>("cascade", {13, -20, false}, 1,
+                                                  {19000, 20, true}, 1000);
+  passed &= testConvergence<Parallel::Coefficient>("parallel", {13, -20, false}, 1,
+                                                   {19000, 20, true}, 1000);
+
+  // High output gain with low shelf. Output coefficient of cascade is normalized at Nyquist
+  // frequency, and it becomes much larger than 1.
+  for (const Parameter& to : {Parameter{20, 20, false}, Parameter{200, 10, false}}) {
+    passed &= testConvergence<Cascade::Coefficient>("cascade", {1000, 0, false}, 1, to, 1000);
+    passed &= testConvergence<Parallel::Coefficient>("parallel", {1000, 0, false}, 1, to, 1000);
+  }
+  return passed;
+}
+
+template<typename Filter> double measureNanosecond(const std::vector<double>& input) {
+  typename Filter::Coefficient co;
+  co.reset(sampleRate, 37, -3, 1, true);
+  std::array<Filter, 2> filter;
+  for (auto& x : filter) { x.reset(); }
+
+  double checksum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto& x : input) {
+    checksum += filter[0].process(x, co);
+    checksum += filter[1].process(-x, co);
+  }
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  volatile double sink = checksum; // Prevents the loop from being removed.
+  (void)sink;
+  return elapsed.count() / double(input.size());
+}
+
+void printTime() {
+  std::mt19937_64 rng(0);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> input(1 << 20);
+  for (auto& x : input) { x = dist(rng); }
+
+  std::cout << std::format("Time per stereo sample: cascade {:.2f} ns, parallel {:.2f} ns.\n",
+                           measureNanosecond<Cascade>(input), measureNanosecond<Parallel>(input));
+}
+
+} // namespace
+
+int main() {
+  const auto grid = parameterGrid();
+
+  bool passed = true;
+  passed &= testMagnitudeResponse(grid);
+  passed &= testNoiseResponse(grid);
+  passed &= testConvergence();
+  printTime();
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+// Copyright Takamitsu Endo (ryukau@gmail.com).
+// SPDX-License-Identifier: AGPL-3.0-only
+
+/*
+Test of `Uhhyou::TelemetryRing`.
+
+- `order`: Records are drained in the order of push, and each record is intact.
+- `full`: `push` fails and counts a drop when the queue is full, and works again after drain.
+- `clear`: `clear` discards pending records, and the queue stays usable.
+- `stress`: A producer thread pushes records while the consumer drains them. Producer retries on
+  full, so every record must arrive in order without gap. Number of failed pushes must be equal to
+  `droppedCount`.
+- `dropping`: Same as `stress`, but the producer doesn't retry and the consumer drains only
+  sometimes. Received and dropped records must sum up to the pushed count, and received sequence
+  numbers must increase.
+
+Build with `-fsanitize=thread` to check data races. See `tools/README.md`.
+
+Usage:
+
+```
+telemetrytest [--records <n>]
+```
+
+Exit code is 0 when all cases pass.
+*/
+
+#include "Uhhyou/dsp/telemetry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+constexpr size_t capacity = 64;
+
+// Payload is derived from `seq`, so that a torn record can be detected.
+struct Record {
+  uint64_t seq;
+  std::array<double, 7> payload;
+};
+
+using Ring = Uhhyou::TelemetryRing<Record, capacity>;
+
+Record makeRecord(uint64_t seq) {
+  Record record{seq, {}};
+  for (size_t i = 0; i < record.payload.size(); ++i) { record.payload[i] = double(seq + i); }
+  return record;
+}
+
+bool isIntact(const Record& record) {
+  for (size_t i = 0; i < record.payload.size(); ++i) {
+    if (record.payload[i] != double(record.seq + i)) { return false; }
+  }
+  return true;
+}
+
+bool report(std::string_view name, bool passed, std::string_view detail) {
+  std::cout << std::format("{} {}: {}\n", passed ? "PASS" : "FAIL", name, detail);
+  return passed;
+}
+
+bool testOrder() {
+  static Ring ring;
+
+  uint64_t seq = 0;
+  uint64_t expected = 0;
+  uint64_t nBad = 0;
+  for (size_t round = 0; round < 100; ++round) {
+    const size_t nPush = round % capacity + 1;
+    for (size_t i = 0; i < nPush; ++i) { ring.push(makeRecord(seq++)); }
+    ring.drain([&](const Record& record) {
+      if (record.seq != expected++ || !isIntact(record)) { ++nBad; }
+    });
+  }
+
+  const bool passed = nBad == 0 && expected == seq && ring.droppedCount() == 0;
+  return report("order", passed, std::format("{} records, {} bad.", seq, nBad));
+}
+
+bool testFull() {
+  static Ring ring;
+
+  size_t nAccepted = 0;
+  for (size_t i = 0; i < capacity + 10; ++i) { nAccepted += ring.push(makeRecord(i)) ? 1 : 0; }
+  const uint64_t dropped = ring.droppedCount();
+
+  uint64_t expected = 0;
+  bool isOrdered = true;
+  const size_t nDrained = ring.drain([&](const Record& record) {
+    isOrdered &= record.seq == expected++ && isIntact(record);
+  });
+  const bool isReusable = ring.push(makeRecord(0));
+
+  const bool passed = nAccepted == capacity && dropped == 10 && nDrained == capacity && isOrdered
+    && isReusable;
+  return report("full", passed,
+                std::format("{} accepted, {} dropped, {} drained.", nAccepted, dropped, nDrained));
+}
+
+bool testClear() {
+  static Ring ring;
+
+  for (size_t i = 0; i < capacity / 2; ++i) { ring.push(makeRecord(i)); }
+  ring.clear();
+  const size_t nAfterClear = ring.drain([](const Record&) {});
+
+  // Indices are wrapped after clear, and a full queue must still fit.
+  size_t nAccepted = 0;
+  for (size_t i = 0; i < capacity; ++i) { nAccepted += ring.push(makeRecord(100 + i)) ? 1 : 0; }
+  uint64_t expected = 100;
+  bool isOrdered = true;
+  ring.drain([&](const Record& record) {
+    isOrdered &= record.seq == expected++ && isIntact(record);
+  });
+
+  const bool passed = nAfterClear == 0 && nAccepted == capacity && isOrdered
+    && ring.droppedCount() == 0;
+  return report("clear", passed,
+                std::format("{} left after clear, {} accepted after.", nAfterClear, nAccepted));
+}
+
+bool testStress(uint64_t nRecord) {
+  static Ring ring;
+
+  std::atomic<uint64_t> nFailedPush{0};
+  std::thread producer([&]() {
+    uint64_t seq = 0;
+    uint64_t nFailed = 0;
+    while (seq < nRecord) {
+      if (ring.push(makeRecord(seq))) {
+        ++seq;
+      } else {
+        ++nFailed;
+        std::this_thread::yield();
+      }
+    }
+    nFailedPush.store(nFailed);
+  });
+
+  uint64_t expected = 0;
+  uint64_t nBad = 0;
+  while (expected < nRecord && nBad == 0) {
+    const size_t count = ring.drain([&](const Record& record) {
+      if (record.seq != expected++ || !isIntact(record)) { ++nBad; }
+    });
+    if (count == 0) { std::this_thread::yield(); }
+  }
+  producer.join();
+
+  const bool passed = nBad == 0 && expected == nRecord
+    && ring.droppedCount() == nFailedPush.load();
+  return report("stress", passed,
+                std::format("{} records, {} bad, {} failed pushes, {} dropped.", expected, nBad,
+                            nFailedPush.load(), ring.droppedCount()));
+}
+
+bool testDropping(uint64_t nRecord) {
+  static Ring ring;
+
+  std::atomic<bool> isDone{false};
+  uint64_t nAccepted = 0;
+  std::thread producer([&]() {
+    for (uint64_t seq = 0; seq < nRecord; ++seq) {
+      nAccepted += ring.push(makeRecord(seq)) ? 1 : 0;
+    }
+    isDone.store(true);
+  });
+
+  uint64_t nReceived = 0;
+  uint64_t nBad = 0;
+  uint64_t next = 0; // Lowest sequence number allowed for the next record.
+  auto receive = [&](const Record& record) {
+    if (record.seq < next || !isIntact(record)) { ++nBad; }
+    next = record.seq + 1;
+    ++nReceived;
+  };
+  while (!isDone.load()) {
+    ring.drain(receive);
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+  producer.join();
+  ring.drain(receive);
+
+  const uint64_t dropped = ring.droppedCount();
+  const bool passed
+    = nBad == 0 && dropped > 0 && nReceived == nAccepted && nReceived + dropped == nRecord;
+  return report("dropping", passed,
+                std::format("{} received, {} dropped, {} bad.", nReceived, dropped, nBad));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  uint64_t nRecord = 2000000;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    if (arg == "--records" && i + 1 < argc) {
+      nRecord = uint64_t(std::max(std::atoll(argv[++i]), 1LL));
+    } else {
+      std::cerr << std::format("Usage: {} [--records <n>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  bool passed = true;
+  passed &= testOrder();
+  passed &= testFull();
+  passed &= testClear();
+  passed &= testStress(nRecord);
+  passed &= testDropping(nRecord);
+  return passed ? 0 : 1;
+}